@@ -29,6 +29,7 @@
 #include <string>
 #include <memory>
 
+#include "fs-utils/io/assetloader.h"
 #include "fs-engine/appcontext.h"
 #include "fs-engine/gfx/screen.h"
 #include "fs-engine/gfx/spritemanager.h"
@@ -131,7 +132,14 @@ protected:
     std::unique_ptr<System> system_;
 
 private:
+    //! Duration of a simulation step in milliseconds
+    static const int kSimulationStep;
+    //! Maximum number of steps played to catch up with a late frame
+    static const int kMaxCatchUpSteps;
+
     bool running_;
+    //! Loads files in background : it must be destroyed after the managers
+    AssetLoader assetLoader_;
     GameSpriteManager game_sprites_;
     SoundManager soundManager_;
     MusicManager music_;
@@ -27,10 +27,13 @@
 #define FONT_H
 
 #include <map>
+#include <string>
+#include <vector>
 #include "utf8.h"
 
 #include "fs-utils/common.h"
 #include "spritemanager.h"
+#include "textruncache.h"
 
 //! This type is used for characters in Code Page 437
 typedef unsigned char cp437char_t;
@@ -53,6 +56,9 @@ private:
 
 /*!
  * Font class.
+ *
+ * A text is first rendered in an image that is kept in a cache of
+ * runs, so a text drawn at each frame costs only a blit.
  */
 class Font {
 public:
@@ -72,13 +78,33 @@ public:
     bool isPrintable(utf8::utfchar32_t codePoint);
 
 protected:
+    //! A glyph to draw in a run
+    struct Glyph {
+        const uint8 *pixels;
+        int width;
+        int height;
+        int stride;
+        //! Position relative to the text position
+        int x;
+        int y;
+    };
+
     static unsigned char decode(const unsigned char * &c, bool dos);
     static int decodeUTF8(const unsigned char * &c);
     Sprite *getSprite(unsigned char dos_char);
+    //! Returns a glyph for the sprite at the given position
+    static Glyph spriteGlyph(Sprite *s, int x, int y);
+    //! Renders the glyphs in a run and adds it to the cache
+    const TextRunCache::Run *addRun(const std::string &key,
+            const std::vector<Glyph> &glyphs, bool x2);
+    //! Draws a run at the text position
+    static void drawRun(int x, int y, const TextRunCache::Run *pRun);
 
     SpriteManager *sprites_;
     int offset_;
     FontRange range_;
+    //! Texts already drawn by this font
+    TextRunCache runs_;
 };
 
 /*!
@@ -123,6 +149,24 @@ public:
 
     //! draw a UTF-8 text at the given position with the given color
     void drawText(int x, int y, const char *text, uint8 toColor);
+
+protected:
+    //! Glyphs of all characters in one color
+    struct ColorAtlas {
+        //! Glyphs one after the other, with no padding
+        std::vector<uint8> pixels;
+        //! Offset of each character in pixels or -1
+        int offsets[256];
+    };
+
+    //! Returns the glyph of the sprite for the character in the given color
+    Glyph coloredGlyph(Sprite *s, unsigned char dos_char, uint8 toColor, int x, int y);
+    //! Returns the atlas for the color, built on first use
+    const ColorAtlas &atlas(uint8 toColor);
+
+protected:
+    //! One atlas for each color used
+    std::map<uint8, ColorAtlas> atlases_;
 };
 
 class HChar {
@@ -40,6 +40,18 @@ public:
     /*! Width of the left control panel*/
     static const int kScreenPanelWidth;
 
+    /*!
+     * A run of opaque pixels in a row of an image.
+     */
+    struct Span {
+        //! Position of the first pixel in the row
+        uint16 start;
+        //! Number of pixels
+        uint16 length;
+        //! Index of the first pixel in the pixels buffer
+        uint32 offset;
+    };
+
     explicit Screen(int width, int height);
     ~Screen();
 
@@ -47,10 +59,18 @@ public:
 
     const uint8 *pixels() const { return pixels_; }
     bool dirty() { return dirty_; }
-    void clearDirty() { dirty_ = false; }
+    //! Returns the first row modified since last call to clearDirty()
+    int dirtyTop() const { return dirtyTop_; }
+    //! Returns the row after the last row modified since last call to clearDirty()
+    int dirtyBottom() const { return dirtyBottom_; }
+    void clearDirty();
+    //! Marks the given rows as modified
+    void markDirty(int y, int height);
 
     void blit(int x, int y, int width, int height, const uint8 *pixeldata,
             bool flipped = false, int stride = 0);
+    void blitSpans(int x, int y, int width, int height, const uint32 *rows,
+            const Span *spans, const uint8 *pixels);
     void blitRect(int x, int y, int width, int height,
                   const uint8 * pixeldata, bool flipped = false, int stride = 0);
     void scale2x(int x, int y, int width, int height, const uint8 *pixeldata,
@@ -76,6 +96,10 @@ protected:
     int height_;
     uint8 *pixels_;
     bool dirty_;
+    //! First modified row
+    int dirtyTop_;
+    //! Row after the last modified row
+    int dirtyBottom_;
     size_t size_logo_;
     uint8 *data_logo_, *data_logo_copy_;
     size_t size_mini_logo_;
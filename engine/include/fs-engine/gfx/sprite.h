@@ -93,6 +93,9 @@ public:
 
     int width() const { return width_; }
     int height() const { return height_; }
+    //! Returns the pixels : lines are stride() bytes long
+    const uint8 *pixels() const { return sprite_data_; }
+    int stride() const { return stride_; }
 
     void data(uint8 *spr_data) const;
 };
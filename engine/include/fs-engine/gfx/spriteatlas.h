@@ -0,0 +1,84 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#ifndef GFX_SPRITEATLAS_H_
+#define GFX_SPRITEATLAS_H_
+
+#include <vector>
+
+#include "fs-utils/common.h"
+#include "fs-engine/gfx/screen.h"
+
+class Sprite;
+
+/*!
+ * Packed copy of a set of sprites stored as opaque spans.
+ *
+ * Each row of a sprite is a list of spans of opaque pixels, so drawing
+ * a sprite copies whole spans and skips the transparent pixels (255)
+ * without testing them. The mirrored image is stored too, so flipped
+ * sprites are drawn the same way.
+ * All spans and pixels are in shared buffers.
+ */
+class SpriteAtlas {
+public:
+    SpriteAtlas();
+
+    //! Builds the atlas from the given sprites
+    void build(const Sprite *sprites, int count);
+    //! Empties the atlas
+    void clear();
+
+    //! Returns true if the sprite is in the atlas
+    bool contains(int spriteNum) const {
+        return spriteNum >= 0 && spriteNum < static_cast<int>(images_.size());
+    }
+    //! Draws the sprite at the given position
+    void draw(int spriteNum, int x, int y, bool flipped = false) const;
+
+    //! Returns the number of opaque pixels stored
+    size_t nbPixels() const { return pixels_.size(); }
+    //! Returns the number of spans stored
+    size_t nbSpans() const { return spans_.size(); }
+
+private:
+    struct Image {
+        int width;
+        int height;
+        //! Index in rows_ of the first row for the normal and flipped image
+        uint32 firstRow[2];
+    };
+
+    void addRows(const Sprite &sprite, bool flipped);
+
+    std::vector<Image> images_;
+    /*!
+     * Spans of row i are in spans_ from rows_[i] to rows_[i + 1].
+     * Each image has height + 1 entries.
+     */
+    std::vector<uint32> rows_;
+    std::vector<Screen::Span> spans_;
+    std::vector<uint8> pixels_;
+};
+
+#endif  // GFX_SPRITEATLAS_H_
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "sprite.h"
+#include "spriteatlas.h"
 #include "fs-utils/misc/singleton.h"
 
 /*!
@@ -99,9 +100,16 @@ public:
     int getFrameNum(int animNum);
 
 protected:
+    //! Directory of the PNG files that replace original sprites
+    static const char *kSpriteOverridesDir;
+
+    void loadSpriteOverrides();
+
     std::vector<int> index_;
     std::vector<GameSpriteFrame> frames_;
     std::vector<GameSpriteFrameElement> elements_;
+    //! Copy of the sprites used to draw the frames
+    SpriteAtlas atlas_;
 };
 
 #define g_SpriteMgr   GameSpriteManager::singleton()
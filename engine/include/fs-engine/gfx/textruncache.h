@@ -0,0 +1,85 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#ifndef GFX_TEXTRUNCACHE_H_
+#define GFX_TEXTRUNCACHE_H_
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "fs-utils/common.h"
+
+/*!
+ * Cache of texts already rendered by a font.
+ *
+ * A run is the image of a whole text with transparent pixels (255), so
+ * drawing a text that has already been drawn costs a single blit.
+ * The key identifies the text and the way it was drawn (color, size...).
+ * Runs are kept in a LRU list limited by a number of runs.
+ */
+class TextRunCache {
+public:
+    //! The image of a text
+    struct Run {
+        //! Position of the image relative to the text position
+        int offsetX;
+        int offsetY;
+        int width;
+        int height;
+        std::vector<uint8> pixels;
+    };
+
+    //! Default max number of runs in the cache
+    static const size_t kDefaultMaxRuns;
+
+    explicit TextRunCache(size_t maxRuns = kDefaultMaxRuns);
+
+    //! Returns the run for the key or NULL
+    const Run *find(const std::string &key);
+    //! Adds a run in the cache and returns it
+    const Run *add(const std::string &key, Run &run);
+    //! Empties the cache
+    void clear();
+
+    //! Returns the number of texts found in the cache
+    uint32 hits() const { return hits_; }
+    //! Returns the number of texts that had to be rendered
+    uint32 misses() const { return misses_; }
+
+private:
+    struct Entry {
+        std::string key;
+        Run run;
+    };
+
+    size_t maxRuns_;
+    //! Most recently used runs are at the front
+    std::list<Entry> lru_;
+    std::map<std::string, std::list<Entry>::iterator> index_;
+    uint32 hits_;
+    uint32 misses_;
+};
+
+#endif  // GFX_TEXTRUNCACHE_H_
@@ -25,6 +25,10 @@
 #ifndef FLIPLAYER_H
 #define FLIPLAYER_H
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "fs-utils/common.h"
 #include "fs-engine/system/system.h"
 
@@ -55,28 +59,65 @@ class MenuManager;
 
 /*!
  * A player for fli animation.
+ *
+ * Frames are decoded by a thread in a small ring of frames, ahead of
+ * their display. nextFrame() takes the oldest decoded frame and
+ * displays it with its palette, or only drops it when the caller is
+ * late. The thread is started by loadFliData() and must be stopped
+ * with stop() before the fli data is deleted.
  */
 class FliPlayer {
 public:
-    FliPlayer(MenuManager *pManager) : fli_data_(0), offscreen_(0) {pManager_ = pManager;}
+    //! Counters on the frames of the current animation
+    struct Stats {
+        //! Number of frames decoded by the thread
+        uint32 decodedFrames;
+        //! Number of frames displayed
+        uint32 shownFrames;
+        //! Number of frames skipped because the player was late
+        uint32 droppedFrames;
+        //! Time spent decoding frames in microseconds
+        uint64 decodeTimeUs;
+    };
+
+    explicit FliPlayer(MenuManager *pManager);
     virtual ~FliPlayer();
 
     //! Play an entire animation without interruption
     bool play(bool intro = false, Font *pIntroFont = NULL);
+    //! Reads the header and starts decoding the frames
     void loadFliData(uint8 *buf);
-    bool decodeFrame();
-    void copyCurrentFrameToScreen();
+    //! Stops the decoding thread
+    void stop();
+    //! Takes the next frame and displays it if show is true
+    bool nextFrame(bool show = true);
 
     int width() const { return fli_data_ ? fli_info_.width : 0; }
     int height() const { return fli_data_ ? fli_info_.height : 0; }
 
     bool hasFrames() const {
-        return fli_data_ ? fli_info_.numFrames > 0 : false;
+        return fli_data_ ? framesLeft_ > 0 : false;
     }
 
-    const uint8 *offscreen() const { return offscreen_; }
+    //! Returns the counters of the current animation
+    Stats stats();
 
 protected:
+    //! Number of frames in the ring
+    static const int kRingSize = 4;
+
+    //! A frame decoded in advance
+    struct DecodedFrame {
+        uint8 *pixels;
+        uint8 palette[256 * 3];
+        //! Incremented each time the palette changes in the animation
+        uint32 paletteVersion;
+    };
+
+    bool decodeFrame();
+    //! Main function of the decoding thread
+    void decodeLoop();
+
     bool isValidChunk(uint16 type);
     ChunkHeader readChunkHeader(uint8 *mem);
     FrameTypeChunkHeader readFrameTypeChunkHeader(ChunkHeader chunkHead,
@@ -85,11 +126,38 @@ protected:
     void decodeDeltaFLC(uint8 *data);
     void setPalette(uint8 *mem);
 
+    //! First frame of the animation : the decoding thread doesn't change it
     uint8 *fli_data_;
-    const uint8 *offscreen_;
+    //! Next chunk to decode : used only by the decoding thread
+    uint8 *decodePos_;
+    //! Frame being decoded : used only by the decoding thread
+    uint8 *offscreen_;
     uint8 palette_[256 * 3];
+    //! Version of palette_
+    uint32 paletteVersion_;
     FliHeader fli_info_;
     MenuManager *pManager_;
+
+    std::thread decoder_;
+    std::mutex mutex_;
+    //! Signals the player that a frame is ready or that decoding is over
+    std::condition_variable frameReady_;
+    //! Signals the decoder that a frame of the ring is free
+    std::condition_variable slotFree_;
+    DecodedFrame ring_[kRingSize];
+    //! Index of the oldest decoded frame in the ring
+    int ringHead_;
+    //! Number of decoded frames in the ring
+    int ringCount_;
+    //! Set by the decoder when there's no more frame to decode
+    bool decodeOver_;
+    //! Set by the player to stop the decoder
+    bool stopDecoder_;
+    //! Number of frames still to be taken
+    int framesLeft_;
+    //! Version of the palette sent to the system
+    uint32 shownPaletteVersion_;
+    Stats stats_;
 };
 
 #endif
@@ -132,6 +132,20 @@ public:
 
     virtual void handleTick(int elapsed) {}
 
+    //! Callback function : Children can re-implement
+    /*!
+     * Returns true if the menu draws objects at positions between two
+     * ticks. In that case, the menu is rendered on every frame.
+     */
+    virtual bool isInterpolating() { return false; }
+
+    //! Callback function : Children can re-implement
+    /*!
+     * Called before each frame is rendered when the menu is interpolating.
+     * \param alpha Part of the simulation step elapsed since the last tick (0 to 1)
+     */
+    virtual void handleInterpolation(float /*alpha*/) {}
+
     //! Callback function : Childs can reimplement
     /*!
      * Called when an action widget has been activated.
@@ -109,7 +109,12 @@ public:
     void setPalette(const char *fname, bool sixbit = true);
 
     //! Displays the current menu
-    void renderMenu();
+    void renderMenu(float alpha = 1.0f);
+
+    //! Returns true if the current menu must be rendered on every frame
+    bool isInterpolating() {
+        return current_ != NULL && current_->isInterpolating();
+    }
 
     //! Returns true if a menu is being displayed
     bool showingMenu() { return current_ != NULL; }
@@ -0,0 +1,69 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#ifndef SOUND_MIDICACHE_H_
+#define SOUND_MIDICACHE_H_
+
+#include <string>
+#include <vector>
+
+#include "fs-utils/common.h"
+
+/*!
+ * On disk cache of the MIDI tracks converted from an original XMI file.
+ *
+ * There is one file per XMI file in the cache folder. It is identified by
+ * the checksum of the XMI data, so the conversion is done again if the
+ * original file changes. The tracks are also protected by a checksum so
+ * a damaged file is never used.
+ */
+class MidiCache {
+public:
+    //! Version of the file format : change it when the conversion changes
+    static const uint32 kVersion;
+
+    //! Loads the tracks converted from the given XMI file
+    static bool load(const std::string &xmiName, uint32 xmiCrc,
+            std::vector<std::vector<uint8>> &tracks);
+    //! Saves the tracks converted from the given XMI file
+    static bool save(const std::string &xmiName, uint32 xmiCrc,
+            const std::vector<std::vector<uint8>> &tracks);
+
+private:
+    //! Header of a cache file. It is followed by the size of each track
+    //! and then by the data of all tracks
+    struct Header {
+        char magic[4];
+        uint32 version;
+        uint32 xmiCrc;
+        uint32 nbTracks;
+        uint32 dataCrc;
+    };
+
+    //! Returns the full path of the cache file for the given XMI file
+    static bool cacheFilePath(const std::string &xmiName, std::string &path);
+    //! Returns the checksum of all the tracks
+    static uint32 tracksChecksum(const std::vector<std::vector<uint8>> &tracks);
+};
+
+#endif  // SOUND_MIDICACHE_H_
@@ -37,6 +37,8 @@ namespace msc {
         TRACK_GAME_COMPLETED,
         TRACK_MISSION_FAILED,
         TRACK_MISSION_COMPLETED,
+        //! Number of tracks
+        NB_TRACKS,
         NO_TRACK = -1
     };
 };
@@ -61,11 +63,13 @@ class Music {
      *
      */
     virtual void stop() const = 0;
-      //! Stops the music with a fade out.
+      //! Starts a fade out of the music and returns without waiting.
     /*!
      * \param ms
      */
     virtual void stopFadeOut(int ms = 200) const = 0;
+      //! Returns true while the music is playing or fading out.
+    virtual bool isPlaying() const = 0;
       //! Loads the music from the given data.
     /*!
      * \param musicData
@@ -107,6 +111,8 @@ class DefaultMusic : public Music {
      * \param ms
      */
       void stopFadeOut(int ms = 200) const {;}
+      //! Returns true while the music is playing or fading out.
+      bool isPlaying() const { return false; }
       //! Loads the music from the given data.
     /*!
      * \param musicData
@@ -37,6 +37,15 @@
 
 /*!
  * Music manager class.
+ *
+ * Tracks are converted from the original XMI files and loaded only
+ * the first time they are played. The converted tracks are kept in
+ * the cache folder so the conversion is done only once.
+ *
+ * Changing the track never waits for the mixer : the current track
+ * is faded out and the new track is queued. update() is called at
+ * each frame and starts the queued track with a fade in once the
+ * fade out is over.
  */
 class MusicManager : public Singleton < MusicManager > {
 public:
@@ -47,6 +56,8 @@ public:
 
     void playTrack(msc::MusicTrack track, int loops = -1);
     void stopPlayback();
+    //! Moves the track transition forward
+    void update(int elapsed);
     //! Sets the music volume to the given level
     void setVolume(int volume);
     //! Returns the current volume
@@ -55,12 +66,46 @@ public:
     void toggleMusic();
 
 protected:
+    //! State of the music playback
+    enum EState {
+        //! No music
+        kStateStopped,
+        //! Current track is playing
+        kStatePlaying,
+        //! Current track is fading out before the queued track plays
+        kStateFadingOut
+    };
+
+    //! Length in milliseconds of the fade out of the current track
+    static const int kFadeOutMs;
+    //! Length in milliseconds of the fade in of the next track
+    static const int kFadeInMs;
+    //! Time after which a fade out is considered to be over
+    static const int kFadeOutTimeout;
+    //! Number of tracks in msc::MusicTrack
+    static const size_t kNbTracks;
+
     bool isAudioInitialized();
+    //! Creates the music for the given track
+    bool loadTrack(msc::MusicTrack track);
+    //! Fills the MIDI data of the tracks of an original file
+    void convertMidiFile(const char *filename, msc::MusicTrack firstTrack);
+    //! Plays the queued track
+    void startQueuedTrack();
 
 protected:
+    //! MIDI data of each track : it must live longer than the musics
+    std::vector<std::vector<uint8>> midiData_;
+    //! Music for each track, NULL until the track is played
     std::vector<std::unique_ptr<Music>> tracks_;
     msc::MusicTrack current_track_;
-    bool is_playing_;
+    EState state_;
+    //! Track played at the end of the fade out
+    msc::MusicTrack next_track_;
+    //! Number of loops for the queued track
+    int next_loops_;
+    //! Time spent in the current fade out
+    int fadeElapsed_;
     /*!
      * Saves the volume level before a mute so
      * we can restore it after a unmute.
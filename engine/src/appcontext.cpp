@@ -115,6 +115,8 @@ bool AppContext::readOrCreateUserConf(const std::string& userConfFolder) {
     fullscreen_ = userConf.read("fullscreen", false);
     playIntro_ = userConf.read("play_intro", true);
     test_files_ = userConf.read("test_data", true);
+    bool cacheUnpacked = userConf.read("cache_unpacked_files", false);
+    File::setUnpackedDiskCacheEnabled(cacheUnpacked);
     const int languageID = userConf.read("language", 0);
     std::string defaultDir;
     File::getDefaultSaveFolder(defaultDir);
@@ -127,6 +129,7 @@ bool AppContext::readOrCreateUserConf(const std::string& userConfFolder) {
         userConf.add("fullscreen", fullscreen_);
         userConf.add("play_intro", playIntro_);
         userConf.add("test_data", test_files_);
+        userConf.add("cache_unpacked_files", cacheUnpacked);
         userConf.add("language", languageID);
         userConf.add("save_data_dir", saveDataDir);
 
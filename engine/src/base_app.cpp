@@ -33,6 +33,9 @@
 #include "mixer/sdlmixeraudio.h"
 #endif // HAVE_SDL_MIXER
 
+const int BaseApp::kSimulationStep = 33;
+const int BaseApp::kMaxCatchUpSteps = 5;
+
 CliParam::CliParam() {
     startMission_ = -1;
     disableSound_ = false;
@@ -119,6 +122,7 @@ BaseApp::BaseApp(MenuFactory *pMenuFactory)
     : context_(std::make_unique<AppContext>()),
       screen_(std::make_unique<Screen>(Screen::kScreenWidth, Screen::kScreenHeight)),
       system_(System::createSystem()),
+      assetLoader_(),
       game_sprites_(),
       soundManager_(),
       music_(),
@@ -183,6 +187,9 @@ void BaseApp::doDestroy() {}
 
 /*!
  * This method defines the application loop.
+ * The game is simulated with steps of fixed duration, and
+ * frames are rendered between steps when the current menu interpolates
+ * the objects positions.
  * \param start_mission Mission id used to start the application in debug mode
  * In standard mode start_mission is always -1.
  */
@@ -219,22 +226,41 @@ void BaseApp::run(const CliParam& param) {
 
     running_ = true;
     int lasttick = system_->getTicks();
+    // time elapsed that has not been simulated yet
+    int accumulator = 0;
     while (running_) {
         int curtick = system_->getTicks();
         int diff_ticks = curtick - lasttick;
+        lasttick = curtick;
         menus_.updtSinceMouseDown(diff_ticks);
+        music_.update(diff_ticks);
 
         FS_Event fsEvt;
         while(system_->pumpEvents(fsEvt)) {
             menus_.handleEvent(fsEvt);
         }
-        if (diff_ticks < 30) {
-            system_->delay(30 - diff_ticks);
+
+        accumulator += diff_ticks;
+        if (accumulator > kMaxCatchUpSteps * kSimulationStep) {
+            // we are too late : game time is slowed down instead of
+            // running many steps that would make us later
+            accumulator = kMaxCatchUpSteps * kSimulationStep;
+        }
+
+        int nbSteps = 0;
+        while (accumulator >= kSimulationStep) {
+            menus_.handleTick(kSimulationStep);
+            accumulator -= kSimulationStep;
+            nbSteps++;
+        }
+
+        if (nbSteps == 0 && !menus_.isInterpolating()) {
+            // nothing will change on screen before the next step
+            system_->delay(kSimulationStep - accumulator);
             continue;
         }
-        menus_.handleTick(diff_ticks);
-        menus_.renderMenu();
-        lasttick = curtick;
+
+        menus_.renderMenu(static_cast<float>(accumulator) / kSimulationStep);
         system_->updateScreen();
     }
 }
@@ -26,6 +26,7 @@
 #include "fs-engine/gfx/font.h"
 
 #include <stdlib.h>
+#include <algorithm>
 
 #include "fs-engine/gfx/screen.h"
 #include "fs-engine/gfx/cp437.h"
@@ -187,37 +188,123 @@ void Font::setSpriteManager(SpriteManager *sprites, int offset, char base, const
 }
 
 void Font::drawText(int x, int y, const char *text, bool dos, bool x2) {
-    int sc = x2 ? 2 : 1;
-    int ox = x;
-    const unsigned char *c = (const unsigned char *)text;
-    for (unsigned char cc = decode(c, dos); cc; cc = decode(c, dos)) {
-        if (cc == 0xff) {
-            // invalid utf8 code, skip it.
-            continue;
+    std::string key;
+    key.push_back(dos ? 'd' : 'u');
+    key.push_back(x2 ? '2' : '1');
+    key.append(text);
+
+    const TextRunCache::Run *pRun = runs_.find(key);
+    if (pRun == NULL) {
+        int sc = x2 ? 2 : 1;
+        int tx = 0, ty = 0;
+        std::vector<Glyph> glyphs;
+        const unsigned char *c = (const unsigned char *)text;
+        for (unsigned char cc = decode(c, dos); cc; cc = decode(c, dos)) {
+            if (cc == 0xff) {
+                // invalid utf8 code, skip it.
+                continue;
+            }
+            if (cc == ' ') {
+                tx += getSprite('A')->width() * sc - sc;
+                continue;
+            }
+            if (cc == '\n') {
+                tx = 0;
+                ty += textHeight() - sc;
+                continue;
+            }
+            Sprite *s = getSprite(cc);
+            if (s) {
+                int y_offset = 0;
+                if (cc == ':')
+                    y_offset = sc;
+                else if (cc == '.' || cc == ',')
+                    y_offset = 4 * sc;
+                else if (cc == '-')
+                    y_offset = 2 * sc;
+
+                glyphs.push_back(spriteGlyph(s, tx, ty + y_offset));
+
+                tx += s->width() * sc - sc;
+            }
         }
-        if (cc == ' ') {
-            x += getSprite('A')->width() * sc - sc;
-            continue;
+        pRun = addRun(key, glyphs, x2);
+    }
+
+    drawRun(x, y, pRun);
+}
+
+Font::Glyph Font::spriteGlyph(Sprite *s, int x, int y) {
+    Glyph glyph;
+    glyph.pixels = s->pixels();
+    glyph.width = s->width();
+    glyph.height = s->height();
+    glyph.stride = s->stride();
+    glyph.x = x;
+    glyph.y = y;
+    return glyph;
+}
+
+/*!
+ * Glyphs are drawn in the order of the list, so a glyph covers the
+ * previous one where they overlap as when they're drawn on screen.
+ * \param key Identifies the text in the cache
+ * \param glyphs The glyphs of the text
+ * \param x2 True if glyphs are drawn twice bigger
+ * \return the run in the cache
+ */
+const TextRunCache::Run *Font::addRun(const std::string &key,
+        const std::vector<Glyph> &glyphs, bool x2) {
+    int sc = x2 ? 2 : 1;
+    TextRunCache::Run run;
+    run.offsetX = run.offsetY = 0;
+    run.width = run.height = 0;
+
+    if (!glyphs.empty()) {
+        int minX = glyphs[0].x, minY = glyphs[0].y;
+        int maxX = minX, maxY = minY;
+        for (const Glyph &glyph : glyphs) {
+            minX = std::min(minX, glyph.x);
+            minY = std::min(minY, glyph.y);
+            maxX = std::max(maxX, glyph.x + glyph.width * sc);
+            maxY = std::max(maxY, glyph.y + glyph.height * sc);
         }
-        if (cc == '\n') {
-            x = ox;
-            y += textHeight() - sc;
-            continue;
+        run.offsetX = minX;
+        run.offsetY = minY;
+        run.width = maxX - minX;
+        run.height = maxY - minY;
+        run.pixels.assign(static_cast<size_t>(run.width * run.height), 255);
+
+        for (const Glyph &glyph : glyphs) {
+            for (int j = 0; j < glyph.height; j++) {
+                const uint8 *src = glyph.pixels + j * glyph.stride;
+                uint8 *dst = run.pixels.data() +
+                    (glyph.y - minY + j * sc) * run.width + glyph.x - minX;
+                for (int i = 0; i < glyph.width; i++) {
+                    uint8 c = src[i];
+                    if (c == 255) {
+                        continue;
+                    }
+                    if (x2) {
+                        dst[i * 2] = c;
+                        dst[i * 2 + 1] = c;
+                        dst[i * 2 + run.width] = c;
+                        dst[i * 2 + 1 + run.width] = c;
+                    } else {
+                        dst[i] = c;
+                    }
+                }
+            }
         }
-        Sprite *s = getSprite(cc);
-        if (s) {
-            int y_offset = 0;
-            if (cc == ':')
-                y_offset = sc;
-            else if (cc == '.' || cc == ',')
-                y_offset = 4 * sc;
-            else if (cc == '-')
-                y_offset = 2 * sc;
+    }
 
-            s->draw(x, y + y_offset, 0, false, x2);
+    return runs_.add(key, run);
+}
 
-            x += s->width() * sc - sc;
-        }
+void Font::drawRun(int x, int y, const TextRunCache::Run *pRun) {
+    if (pRun->width > 0) {
+        g_Screen.blit(x + pRun->offsetX, y + pRun->offsetY, pRun->width,
+                pRun->height, pRun->pixels.data());
     }
 }
 
@@ -297,40 +384,53 @@ void MenuFont::setSpriteManager(SpriteManager *sprites, int darkOffset, int ligh
 }
 
 void MenuFont::drawText(int x, int y, bool dos, const char *text, bool highlighted, bool x2) {
-    int sc = x2 ? 2 : 1;
-    int ox = x;
-    const unsigned char *c = (const unsigned char *)text;
-    Sprite *pDef = getSprite('A', false);
-    for (unsigned char cc = decode(c, dos); cc; cc = decode(c, dos)) {
-        if (cc == 0xff) {
-            // invalid utf8 code, skip it.
-            continue;
-        }
-        if (cc == ' ') {
-            x += pDef->width() * sc - sc;
-            continue;
-        }
-        if (cc == '\n') {
-            x = ox;
-            y += textHeight() - sc;
-            continue;
-        }
-        Sprite *s = getSprite(cc, highlighted);
-        if (s) {
-            int y_offset = 0;
-            if (cc == ':')
-                y_offset = sc;
-            else if (cc == '.' || cc == ',' || cc == '-' || cc == '_')
-                y_offset = pDef->height() *sc - getSprite(cc, false)->height() * sc;
-            else if (cc == '/') {
-                y_offset = (pDef->height() *sc)/2 - (getSprite('/', false)->height() * sc) / 2;
+    std::string key;
+    key.push_back(dos ? 'd' : 'u');
+    key.push_back(x2 ? '2' : '1');
+    key.push_back(highlighted ? 'l' : 'n');
+    key.append(text);
+
+    const TextRunCache::Run *pRun = runs_.find(key);
+    if (pRun == NULL) {
+        int sc = x2 ? 2 : 1;
+        int tx = 0, ty = 0;
+        std::vector<Glyph> glyphs;
+        const unsigned char *c = (const unsigned char *)text;
+        Sprite *pDef = getSprite('A', false);
+        for (unsigned char cc = decode(c, dos); cc; cc = decode(c, dos)) {
+            if (cc == 0xff) {
+                // invalid utf8 code, skip it.
+                continue;
+            }
+            if (cc == ' ') {
+                tx += pDef->width() * sc - sc;
+                continue;
+            }
+            if (cc == '\n') {
+                tx = 0;
+                ty += textHeight() - sc;
+                continue;
+            }
+            Sprite *s = getSprite(cc, highlighted);
+            if (s) {
+                int y_offset = 0;
+                if (cc == ':')
+                    y_offset = sc;
+                else if (cc == '.' || cc == ',' || cc == '-' || cc == '_')
+                    y_offset = pDef->height() *sc - getSprite(cc, false)->height() * sc;
+                else if (cc == '/') {
+                    y_offset = (pDef->height() *sc)/2 - (getSprite('/', false)->height() * sc) / 2;
+                }
+
+                glyphs.push_back(spriteGlyph(s, tx, ty + y_offset));
+
+                tx += s->width() * sc - sc;
             }
-
-            s->draw(x, y + y_offset, 0, false, x2);
-
-            x += s->width() * sc - sc;
         }
+        pRun = addRun(key, glyphs, x2);
     }
+
+    drawRun(x, y, pRun);
 }
 
 GameFont::GameFont() :Font() {}
@@ -343,55 +443,111 @@ GameFont::GameFont() :Font() {}
  * \param toColor The color used to draw the text.
  */
 void GameFont::drawText(int x, int y, const char *text, uint8 toColor) {
-    int sc = 1;
-    int ox = x;
-    uint8 fromColor = 252;
-    const unsigned char *c = (const unsigned char *)text;
-    Sprite *pDef = getSprite('A');
-    for (unsigned char cc = decode(c, false); cc; cc = decode(c, false)) {
-        if (cc == 0xff) {
-            // invalid utf8 code, skip it.
-            continue;
-        }
-        if (cc == ' ') {
-            // If char is a space, only move the drawing origin to the left
-            x += pDef->width() * sc - sc;
-            continue;
-        }
-        if (cc == '\n') {
-            // If char is a space, only move the drawing origin to the next line
-            x = ox;
-            y += textHeight() - sc;
-            continue;
-        }
-        // get the sprite for the caracter
-        Sprite *s = getSprite(cc);
-        if (s) {
-            int y_offset = 0;
-            // Add some offset correct for special caracters as ':' '.' ',' '-'
-            if (cc == ':')
-                y_offset = sc;
-            else if (cc == '.' || cc == ',' || cc == '-')
-                y_offset = pDef->height() *sc - getSprite(cc)->height() * sc;
-            else if (cc == '/') {
-                y_offset = (pDef->height() *sc)/2 - (getSprite('/')->height() * sc) / 2;
+    std::string key;
+    key.push_back(static_cast<char>(toColor));
+    key.append(text);
+
+    const TextRunCache::Run *pRun = runs_.find(key);
+    if (pRun == NULL) {
+        int sc = 1;
+        int tx = 0, ty = 0;
+        std::vector<Glyph> glyphs;
+        const unsigned char *c = (const unsigned char *)text;
+        Sprite *pDef = getSprite('A');
+        for (unsigned char cc = decode(c, false); cc; cc = decode(c, false)) {
+            if (cc == 0xff) {
+                // invalid utf8 code, skip it.
+                continue;
+            }
+            if (cc == ' ') {
+                // If char is a space, only move the drawing origin to the left
+                tx += pDef->width() * sc - sc;
+                continue;
+            }
+            if (cc == '\n') {
+                // If char is a space, only move the drawing origin to the next line
+                tx = 0;
+                ty += textHeight() - sc;
+                continue;
             }
+            // get the sprite for the caracter
+            Sprite *s = getSprite(cc);
+            if (s) {
+                int y_offset = 0;
+                // Add some offset correct for special caracters as ':' '.' ',' '-'
+                if (cc == ':')
+                    y_offset = sc;
+                else if (cc == '.' || cc == ',' || cc == '-')
+                    y_offset = pDef->height() *sc - getSprite(cc)->height() * sc;
+                else if (cc == '/') {
+                    y_offset = (pDef->height() *sc)/2 - (getSprite('/')->height() * sc) / 2;
+                }
+
+                glyphs.push_back(coloredGlyph(s, cc, toColor, tx, ty + y_offset));
+
+                tx += s->width() * sc - sc;
+            }
+        }
+        pRun = addRun(key, glyphs, false);
+    }
+
+    drawRun(x, y, pRun);
+}
 
-            uint8 *data = new uint8[s->width() * s->height()];
-            s->data(data);
+/*!
+ * \param s The sprite returned by getSprite() for the character
+ * \param dos_char The character
+ * \param toColor The color of the text
+ * \param x Position of the glyph
+ * \param y Position of the glyph
+ */
+Font::Glyph GameFont::coloredGlyph(Sprite *s, unsigned char dos_char, uint8 toColor, int x, int y) {
+    const ColorAtlas &colorAtlas = atlas(toColor);
+    // getSprite() replaces characters out of range by '?'
+    int offset = colorAtlas.offsets[range_.in_range(dos_char) ? dos_char : '?'];
+    if (offset < 0) {
+        return spriteGlyph(s, x, y);
+    }
 
-            // Change original color to the specified color
-            for (int i = 0; i < s->width() * s->height(); i++)
-                data[i] = (data[i] == fromColor ? toColor : 255);
+    Glyph glyph;
+    glyph.pixels = colorAtlas.pixels.data() + offset;
+    glyph.width = s->width();
+    glyph.height = s->height();
+    glyph.stride = s->width();
+    glyph.x = x;
+    glyph.y = y;
+    return glyph;
+}
 
-            // draw modified sprite
-            g_Screen.blit(x, y + y_offset, s->width(), s->height(), data);
+/*!
+ * The atlas contains all characters of the font where the original
+ * color is replaced by the given color and all other pixels are transparent.
+ */
+const GameFont::ColorAtlas &GameFont::atlas(uint8 toColor) {
+    std::map<uint8, ColorAtlas>::iterator it = atlases_.find(toColor);
+    if (it != atlases_.end()) {
+        return it->second;
+    }
 
-            delete[] data;
+    const uint8 fromColor = 252;
+    ColorAtlas &colorAtlas = atlases_[toColor];
+    for (int c = 0; c < 256; c++) {
+        colorAtlas.offsets[c] = -1;
+        Sprite *s = range_.in_range(static_cast<unsigned char>(c)) ? sprites_->sprite(c + offset_) : NULL;
+        if (s == NULL) {
+            continue;
+        }
 
-            x += s->width() * sc - sc;
+        colorAtlas.offsets[c] = static_cast<int>(colorAtlas.pixels.size());
+        for (int j = 0; j < s->height(); j++) {
+            const uint8 *src = s->pixels() + j * s->stride();
+            for (int i = 0; i < s->width(); i++) {
+                colorAtlas.pixels.push_back(src[i] == fromColor ? toColor : 255);
+            }
         }
     }
+
+    return colorAtlas;
 }
 
 HChar::HChar():width_(0), height_(0), bits_(0) {
@@ -38,6 +38,8 @@ Screen::Screen(int width, int height)
 , height_(height)
 , pixels_(NULL)
 , dirty_(false)
+, dirtyTop_(0)
+, dirtyBottom_(0)
 , data_logo_(NULL), data_logo_copy_(NULL)
 , data_mini_logo_(NULL), data_mini_logo_copy_(NULL)
 {
@@ -63,7 +65,39 @@ Screen::~Screen()
 void Screen::clear(uint8 color)
 {
     memset(pixels_, color, width_ * height_);
-    dirty_ = true;
+    markDirty(0, height_);
+}
+
+void Screen::clearDirty()
+{
+    dirty_ = false;
+    dirtyTop_ = 0;
+    dirtyBottom_ = 0;
+}
+
+/*!
+ * Rows are clipped to the screen. The dirty rows are kept as a single
+ * band so that the system knows which part of the screen to update.
+ * @param y first row
+ * @param height number of rows
+ */
+void Screen::markDirty(int y, int height)
+{
+    int top = y < 0 ? 0 : y;
+    int bottom = y + height > height_ ? height_ : y + height;
+    if (top >= bottom)
+        return;
+
+    if (!dirty_) {
+        dirtyTop_ = top;
+        dirtyBottom_ = bottom;
+        dirty_ = true;
+    } else {
+        if (top < dirtyTop_)
+            dirtyTop_ = top;
+        if (bottom > dirtyBottom_)
+            dirtyBottom_ = bottom;
+    }
 }
 /*!
  * Blits data to screen
@@ -130,7 +164,54 @@ void Screen::blit(int x, int y, int width, int height,
         }
     }
 
-    dirty_ = true;
+    markDirty(clipped_y, h);
+}
+
+/*!
+ * Blits an image stored as spans of opaque pixels. Pixels of a span are
+ * copied at once and transparent pixels are never read.
+ * @param x position by x coord
+ * @param y position by y coord
+ * @param width image's width
+ * @param height image's height
+ * @param rows spans of row j are from rows[j] to rows[j + 1] (height + 1 entries)
+ * @param spans all spans
+ * @param pixels pixels of the spans
+ * @sa spriteatlas.h
+ */
+void Screen::blitSpans(int x, int y, int width, int height, const uint32 *rows,
+                       const Span *spans, const uint8 *pixels)
+{
+    if (x + width < 0 || y + height < 0 || x >= width_ || y >= height_)
+        return;
+
+    int first = y < 0 ? -y : 0;
+    int last = y + height > height_ ? height_ - y : height;
+    bool clipX = x < 0 || x + width > width_;
+
+    uint8 *d = pixels_ + (y + first) * width_;
+    for (int j = first; j < last; ++j, d += width_) {
+        const Span *span = spans + rows[j];
+        const Span *end = spans + rows[j + 1];
+        if (!clipX) {
+            for (; span != end; ++span)
+                memcpy(d + x + span->start, pixels + span->offset, span->length);
+            continue;
+        }
+
+        for (; span != end; ++span) {
+            int start = x + span->start;
+            int stop = start + span->length;
+            int skip = start < 0 ? -start : 0;
+            if (stop > width_)
+                stop = width_;
+            if (start + skip < stop)
+                memcpy(d + start + skip, pixels + span->offset + skip,
+                       static_cast<size_t>(stop - start - skip));
+        }
+    }
+
+    markDirty(y + first, last - first);
 }
 
 /*!
@@ -187,7 +268,7 @@ void Screen::blitRect(int x, int y, int width, int height,
         }
     }
 
-    dirty_ = true;
+    markDirty(dest_y, clipped_h);
 }
 
 void Screen::scale2x(int x, int y, int width, int height,
@@ -211,7 +292,7 @@ void Screen::scale2x(int x, int y, int width, int height,
         pixeldata += stride;
     }
 
-    dirty_ = true;
+    markDirty(y, height * 2);
 }
 
 void Screen::drawVLine(int x, int y, int length, uint8 color)
@@ -227,13 +308,13 @@ void Screen::drawVLine(int x, int y, int length, uint8 color)
     if (length < 1)
         return;
 
+    markDirty(y, length);
+
     uint8 *pixel = pixels_ + y * width_ + x;
     while (length--) {
         *pixel = color;
         pixel += width_;
     }
-
-    dirty_ = true;
 }
 
 void Screen::drawHLine(int x, int y, int length, uint8 color)
@@ -253,7 +334,7 @@ void Screen::drawHLine(int x, int y, int length, uint8 color)
     while (length--)
         *pixel_ptr++ = color;
 
-    dirty_ = true;
+    markDirty(y, 1);
 }
 
 int Screen::numLogos()
@@ -286,8 +367,6 @@ void Screen::drawLogo(int x, int y, int logo, int colour, bool mini)
         scale2x(x, y, 16, 16, data_mini_logo_copy_ + logo * 16 * 16, 16);
     else
         scale2x(x, y, 32, 32, data_logo_copy_ + logo * 32 * 32, 32);
-
-    dirty_ = true;
 }
 
 // Taken from SDL_gfx
@@ -350,7 +429,7 @@ void Screen::drawLine(int x1, int y1, int x2, int y2, uint8 color,
         }
     }
 
-    dirty_ = true;
+    markDirty(y1 < y2 ? y1 : y2, ABS(y2 - y1) + 1);
 }
 
 void Screen::setPixel(int x, int y, uint8 color)
@@ -358,7 +437,7 @@ void Screen::setPixel(int x, int y, uint8 color)
     if (x < 0 || y < 0 || x >= width_ || y >= height_)
         return;
     pixels_[y * width_ + x] = color;
-    dirty_ = true;
+    markDirty(y, 1);
 }
 
 
@@ -375,7 +454,7 @@ void Screen::drawRect(int x, int y, int width, int height, uint8 color)
         for (int w = 0; w != width; w++)
             *p_pixels++ = color;
     }
-    dirty_ = true;
+    markDirty(y, height);
 }
 
 int Screen::gameScreenHeight()
@@ -0,0 +1,112 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include "fs-engine/gfx/spriteatlas.h"
+
+#include "fs-engine/gfx/sprite.h"
+
+SpriteAtlas::SpriteAtlas()
+{
+}
+
+void SpriteAtlas::clear()
+{
+    images_.clear();
+    rows_.clear();
+    spans_.clear();
+    pixels_.clear();
+}
+
+void SpriteAtlas::build(const Sprite *sprites, int count)
+{
+    clear();
+    images_.resize(static_cast<size_t>(count));
+
+    for (int i = 0; i < count; ++i) {
+        const Sprite &sprite = sprites[i];
+        Image &img = images_[static_cast<size_t>(i)];
+        img.width = sprite.width();
+        img.height = sprite.pixels() ? sprite.height() : 0;
+
+        img.firstRow[0] = static_cast<uint32>(rows_.size());
+        addRows(sprite, false);
+        img.firstRow[1] = static_cast<uint32>(rows_.size());
+        addRows(sprite, true);
+    }
+
+    // releases the memory reserved while growing
+    std::vector<uint32>(rows_).swap(rows_);
+    std::vector<Screen::Span>(spans_).swap(spans_);
+    std::vector<uint8>(pixels_).swap(pixels_);
+}
+
+/*!
+ * Adds height + 1 entries in rows_ and the spans of each row.
+ * For the flipped image, spans are mirrored and their pixels are
+ * stored in reverse order.
+ */
+void SpriteAtlas::addRows(const Sprite &sprite, bool flipped)
+{
+    const uint8 *pixels = sprite.pixels();
+    int width = sprite.width();
+    int height = pixels ? sprite.height() : 0;
+
+    for (int j = 0; j < height; ++j) {
+        rows_.push_back(static_cast<uint32>(spans_.size()));
+
+        const uint8 *row = pixels + j * sprite.stride();
+        int i = 0;
+        while (i < width) {
+            int pos = flipped ? width - 1 - i : i;
+            if (row[pos] == 255) {
+                i++;
+                continue;
+            }
+
+            Screen::Span span;
+            span.start = static_cast<uint16>(i);
+            span.offset = static_cast<uint32>(pixels_.size());
+            while (i < width) {
+                pos = flipped ? width - 1 - i : i;
+                if (row[pos] == 255)
+                    break;
+                pixels_.push_back(row[pos]);
+                i++;
+            }
+            span.length = static_cast<uint16>(i - span.start);
+            spans_.push_back(span);
+        }
+    }
+    rows_.push_back(static_cast<uint32>(spans_.size()));
+}
+
+void SpriteAtlas::draw(int spriteNum, int x, int y, bool flipped) const
+{
+    const Image &img = images_[static_cast<size_t>(spriteNum)];
+    if (img.height == 0)
+        return;
+
+    g_Screen.blitSpans(x, y, img.width, img.height,
+            rows_.data() + img.firstRow[flipped ? 1 : 0],
+            spans_.data(), pixels_.data());
+}
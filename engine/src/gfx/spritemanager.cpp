@@ -26,9 +26,18 @@
 
 #include <stdio.h>
 #include <assert.h>
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
 
 #include "fs-utils/io/file.h"
 #include "fs-utils/log/log.h"
+#include "fs-utils/misc/workerpool.h"
+
+const char *GameSpriteManager::kSpriteOverridesDir = "sprites";
 
 SpriteManager::SpriteManager():sprites_(NULL), sprite_count_(0)
 {
@@ -160,14 +169,11 @@ void GameSpriteManager::load()
 
     LOG(Log::k_FLG_SND, "GameSpriteManager", "load", ("loaded %i frame elements", (int)elements_.size()))
 
-    for (unsigned int i = 0; i < elements_.size(); i++) {
-        int esprite = elements_[i].sprite_;
-        if (esprite) {
-            char tmp[1024];
-            sprintf(tmp, "sprites/%i.png", esprite);
-            sprites_[esprite].loadSpriteFromPNG(tmp);
-        }
-    }
+    loadSpriteOverrides();
+
+    atlas_.build(sprites_, sprite_count_);
+    LOG(Log::k_FLG_GFX, "GameSpriteManager", "load", ("sprite atlas contains %i spans and %i pixels",
+            (int)atlas_.nbSpans(), (int)atlas_.nbPixels()))
 
     fp = File::openOriginalFile("HFRA-0.TXT");
     if (fp) {
@@ -230,6 +236,72 @@ void GameSpriteManager::load()
     LOG(Log::k_FLG_SND, "GameSpriteManager", "load", ("index contains %i animations", (int)index_.size()))
 }
 
+/*!
+ * Sprites used by frame elements can be replaced by a PNG file named
+ * after the sprite number in the "sprites" directory, like "12.png".
+ * Numbers with leading zeros are ignored and the extension is not case
+ * sensitive : if several files give the same sprite, "12.png" wins, else
+ * the first name in alphabetical order.
+ * The directory is read once and only the files found are loaded, in
+ * parallel as each file goes in its own sprite.
+ */
+void GameSpriteManager::loadSpriteOverrides()
+{
+    std::error_code ec;
+    fs::directory_iterator it(kSpriteOverridesDir, ec);
+    if (ec) {
+        // no overrides
+        return;
+    }
+
+    std::set<int> used;
+    for (size_t i = 0; i < elements_.size(); i++) {
+        if (elements_[i].sprite_)
+            used.insert(elements_[i].sprite_);
+    }
+
+    std::map<int, std::string> files;
+    for (; it != fs::directory_iterator(); it.increment(ec)) {
+        const fs::path &path = it->path();
+        std::string stem = path.stem().string();
+        std::string ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(),
+                [](unsigned char c){
+                    return static_cast<char>(std::tolower(c)); }
+                );
+        if (ext != ".png" || stem.empty() || stem.size() > 9 ||
+                stem.find_first_not_of("0123456789") != std::string::npos ||
+                (stem[0] == '0' && stem.size() > 1))
+            continue;
+
+        int spriteNum = atoi(stem.c_str());
+        if (spriteNum >= sprite_count_ || used.find(spriteNum) == used.end())
+            continue;
+
+        std::string file = path.string();
+        std::map<int, std::string>::iterator found = files.find(spriteNum);
+        if (found == files.end()) {
+            files[spriteNum] = file;
+        } else if (path.extension() == ".png"
+                || (fs::path(found->second).extension() != ".png" && file < found->second)) {
+            found->second = file;
+        }
+    }
+
+    if (files.empty())
+        return;
+
+    // one entry per sprite, so workers never decode in the same sprite
+    std::vector<std::pair<int, std::string> > overrides(files.begin(), files.end());
+    fs_utils::WorkerPool pool(fs_utils::WorkerPool::defaultSize());
+    pool.run(overrides.size(), [this, &overrides](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++)
+            sprites_[overrides[i].first].loadSpriteFromPNG(overrides[i].second.c_str());
+    });
+
+    LOG(Log::k_FLG_GFX, "GameSpriteManager", "loadSpriteOverrides", ("loaded %i sprite overrides", (int)overrides.size()))
+}
+
 bool GameSpriteManager::drawFrame(int animNum, int frameNum, const Point2D &screenPos)
 {
     assert(animNum < (int) index_.size());
@@ -245,8 +317,8 @@ bool GameSpriteManager::drawFrame(int animNum, int frameNum, const Point2D &scre
 
     GameSpriteFrameElement *e = &elements_[f->first_element_];
     while (1) {
-        sprites_[e->sprite_].draw(screenPos.x + e->off_x_, screenPos.y + e->off_y_, 0,
-                                  e->flipped_);
+        atlas_.draw(e->sprite_, screenPos.x + e->off_x_, screenPos.y + e->off_y_,
+                    e->flipped_);
         if (e->next_element_ == 0)
             break;
         e = &elements_[e->next_element_];
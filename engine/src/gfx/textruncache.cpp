@@ -0,0 +1,82 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include "fs-engine/gfx/textruncache.h"
+
+const size_t TextRunCache::kDefaultMaxRuns = 128;
+
+TextRunCache::TextRunCache(size_t maxRuns) : maxRuns_(maxRuns) {
+    hits_ = 0;
+    misses_ = 0;
+}
+
+/*!
+ * A found run becomes the most recently used.
+ * \param key Identifies the text
+ * \return NULL if the text is not in the cache
+ */
+const TextRunCache::Run *TextRunCache::find(const std::string &key) {
+    std::map<std::string, std::list<Entry>::iterator>::iterator it = index_.find(key);
+    if (it == index_.end()) {
+        misses_++;
+        return NULL;
+    }
+
+    lru_.splice(lru_.begin(), lru_, it->second);
+    hits_++;
+    return &it->second->run;
+}
+
+/*!
+ * The least recently used run is removed when the cache is full.
+ * \param key Identifies the text
+ * \param run The run : its content is moved to the cache
+ * \return The run in the cache
+ */
+const TextRunCache::Run *TextRunCache::add(const std::string &key, Run &run) {
+    std::map<std::string, std::list<Entry>::iterator>::iterator it = index_.find(key);
+    if (it != index_.end()) {
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+    while (!lru_.empty() && lru_.size() >= maxRuns_) {
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+    }
+
+    lru_.push_front(Entry());
+    lru_.front().key = key;
+    lru_.front().run.offsetX = run.offsetX;
+    lru_.front().run.offsetY = run.offsetY;
+    lru_.front().run.width = run.width;
+    lru_.front().run.height = run.height;
+    lru_.front().run.pixels.swap(run.pixels);
+    index_[key] = lru_.begin();
+    return &lru_.front().run;
+}
+
+void TextRunCache::clear() {
+    lru_.clear();
+    index_.clear();
+}
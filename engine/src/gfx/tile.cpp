@@ -80,7 +80,11 @@ bool Tile::drawTo(uint8 * screen, int swidth, int sheight, int x, int y)
 
 bool Tile::drawToScreen(int x, int y)
 {
-    return drawTo((uint8*) g_Screen.pixels(), g_Screen.gameScreenWidth(), g_Screen.gameScreenHeight(), x, y);
+    if (drawTo((uint8*) g_Screen.pixels(), g_Screen.gameScreenWidth(), g_Screen.gameScreenHeight(), x, y)) {
+        g_Screen.markDirty(y, TILE_HEIGHT);
+        return true;
+    }
+    return false;
 }
 
 uint8 Tile::getWalkData() {
@@ -24,6 +24,7 @@
 
 #include "fs-engine/menus/fliplayer.h"
 
+#include <chrono>
 #include <cstdio>
 
 #include "fs-utils/log/log.h"
@@ -194,14 +195,43 @@ const sample_timings g_rg_sample_offsets_and_timings[] = {
 
 #endif
 
+FliPlayer::FliPlayer(MenuManager *pManager) : fli_data_(NULL), decodePos_(NULL),
+        offscreen_(NULL) {
+    pManager_ = pManager;
+    paletteVersion_ = 0;
+    fli_info_.numFrames = 0;
+    for (int i = 0; i < kRingSize; i++) {
+        ring_[i].pixels = NULL;
+    }
+    ringHead_ = 0;
+    ringCount_ = 0;
+    decodeOver_ = true;
+    stopDecoder_ = false;
+    framesLeft_ = 0;
+    shownPaletteVersion_ = 0;
+    memset(&stats_, 0, sizeof(stats_));
+}
+
 FliPlayer::~FliPlayer() {
+    stop();
+
     if (offscreen_) {
         delete[] offscreen_;
         offscreen_ = NULL;
     }
+
+    for (int i = 0; i < kRingSize; i++) {
+        delete[] ring_[i].pixels;
+    }
 }
 
+/*!
+ * The data must not be deleted before the end of the animation
+ * or a call to stop().
+ */
 void FliPlayer::loadFliData(uint8 *data) {
+    stop();
+
     fli_data_ = data;
 
     fli_info_.size = READ_LE_UINT32(fli_data_);
@@ -219,15 +249,139 @@ void FliPlayer::loadFliData(uint8 *data) {
         FSERR(Log::k_FLG_GFX, "FliPlayer", "loadFliData()", ("Attempted to load non-FLI data (type = 0x%04X)\n", fli_info_.type));
         fli_info_.width = fli_info_.height = 100;
         fli_info_.numFrames = 0;
+        framesLeft_ = 0;
         return;
     }
 
     assert(fli_info_.width == 320 && fli_info_.height == 200);
-    if (offscreen_)
-        delete[] offscreen_;
-    offscreen_ = new uint8[fli_info_.width * fli_info_.height];
+    int frameSize = fli_info_.width * fli_info_.height;
+    if (offscreen_ == NULL) {
+        // All animations have the same size
+        offscreen_ = new uint8[frameSize];
+        for (int i = 0; i < kRingSize; i++) {
+            ring_[i].pixels = new uint8[frameSize];
+        }
+    }
 
     memset(palette_, 0, sizeof(palette_));
+    paletteVersion_ = 0;
+    shownPaletteVersion_ = 0;
+    ringHead_ = 0;
+    ringCount_ = 0;
+    decodeOver_ = false;
+    stopDecoder_ = false;
+    framesLeft_ = fli_info_.numFrames;
+    memset(&stats_, 0, sizeof(stats_));
+
+    decodePos_ = fli_data_;
+    decoder_ = std::thread(&FliPlayer::decodeLoop, this);
+}
+
+/*!
+ * Waits for the end of the decoding thread. After that call, there's
+ * no more frame to play.
+ */
+void FliPlayer::stop() {
+    if (decoder_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopDecoder_ = true;
+        }
+        slotFree_.notify_one();
+        decoder_.join();
+    }
+    framesLeft_ = 0;
+}
+
+/*!
+ * Decodes frames while there's a free frame in the ring.
+ * A frame that can't be decoded ends the animation.
+ */
+void FliPlayer::decodeLoop() {
+    size_t frameSize = static_cast<size_t>(fli_info_.width) * fli_info_.height;
+    while (fli_info_.numFrames > 0) {
+        int slot;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            slotFree_.wait(lock, [this] { return stopDecoder_ || ringCount_ < kRingSize; });
+            if (stopDecoder_) {
+                break;
+            }
+            // This frame is not used by the player until ringCount_ is incremented
+            slot = (ringHead_ + ringCount_) % kRingSize;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        bool valid = decodeFrame();
+        if (valid) {
+            memcpy(ring_[slot].pixels, offscreen_, frameSize);
+            memcpy(ring_[slot].palette, palette_, sizeof(palette_));
+            ring_[slot].paletteVersion = paletteVersion_;
+        }
+        auto decodeTime = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.decodeTimeUs += static_cast<uint64>(decodeTime.count());
+        if (!valid) {
+            break;
+        }
+        stats_.decodedFrames++;
+        ringCount_++;
+        frameReady_.notify_one();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    decodeOver_ = true;
+    frameReady_.notify_one();
+}
+
+/*!
+ * Waits for the next decoded frame if it's not ready yet. The last frame
+ * of the animation is always displayed.
+ * \param show False to drop the frame when the caller is late
+ * \return False if there is no more frame
+ */
+bool FliPlayer::nextFrame(bool show) {
+    if (!hasFrames()) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    frameReady_.wait(lock, [this] { return ringCount_ > 0 || decodeOver_; });
+    if (ringCount_ == 0) {
+        // Animation has ended on a frame that could not be decoded
+        framesLeft_ = 0;
+        return false;
+    }
+    lock.unlock();
+
+    DecodedFrame &frame = ring_[ringHead_];
+    framesLeft_--;
+    if (show || framesLeft_ == 0) {
+        if (frame.paletteVersion != shownPaletteVersion_) {
+            g_System.setPalette8b3(frame.palette);
+            shownPaletteVersion_ = frame.paletteVersion;
+        }
+        g_Screen.scale2x(0, 0, fli_info_.width, fli_info_.height, frame.pixels,
+                         0, false);
+    }
+
+    lock.lock();
+    if (show || framesLeft_ == 0) {
+        stats_.shownFrames++;
+    } else {
+        stats_.droppedFrames++;
+    }
+    ringHead_ = (ringHead_ + 1) % kRingSize;
+    ringCount_--;
+    slotFree_.notify_one();
+    return true;
+}
+
+FliPlayer::Stats FliPlayer::stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
 }
 
 bool FliPlayer::isValidChunk(uint16 type) {
@@ -367,21 +521,21 @@ void FliPlayer::decodeDeltaFLC(uint8 *data) {
 
 bool FliPlayer::decodeFrame() {
     FrameTypeChunkHeader frameHeader;
-    ChunkHeader cHeader = readChunkHeader(fli_data_);
+    ChunkHeader cHeader = readChunkHeader(decodePos_);
     do {
         switch (cHeader.type) {
         case 4:
-            setPalette(fli_data_ + 6);
-            g_System.setPalette8b3(palette_);
+            setPalette(decodePos_ + 6);
+            paletteVersion_++;
             break;
         case 7:
-            decodeDeltaFLC(fli_data_ + 6);
+            decodeDeltaFLC(decodePos_ + 6);
             break;
         case 15:
-            decodeByteRun(fli_data_ + 6);
+            decodeByteRun(decodePos_ + 6);
             break;
         case FRAME_TYPE:
-            frameHeader = readFrameTypeChunkHeader(cHeader, fli_data_);
+            frameHeader = readFrameTypeChunkHeader(cHeader, decodePos_);
             fli_info_.numFrames--;
             //printf("Frames Remaining: %d\n", fli_info_.numFrames);
             break;
@@ -390,9 +544,9 @@ bool FliPlayer::decodeFrame() {
         }
 
         if (cHeader.type != FRAME_TYPE)
-            fli_data_ += cHeader.size;
+            decodePos_ += cHeader.size;
 
-        cHeader = readChunkHeader(fli_data_);
+        cHeader = readChunkHeader(decodePos_);
 
     } while (isValidChunk(cHeader.type) && cHeader.type != FRAME_TYPE);
 
@@ -429,17 +583,18 @@ void FliPlayer::setPalette(uint8 *mem) {
     }
 }
 
-void FliPlayer::copyCurrentFrameToScreen() {
-    g_Screen.scale2x(0, 0, fli_info_.width, fli_info_.height, offscreen(),
-                     0, false);
-}
-
+/*!
+ * Frames are displayed at a fixed rate : when a frame is late by more
+ * than the length of a frame, it is dropped to catch up.
+ */
 bool FliPlayer::play(bool intro, Font *pIntroFont) {
     if (!fli_data_)
         return false;
 
     g_Screen.clear(0);
-    int cur_frame = 0;
+    const uint32 frameLength = intro ? 100 : 66;      // 10 or 15 fps
+    uint32 startTime = g_System.getTicks();
+    uint32 frameIndex = 0;
     while (hasFrames()) {
         // Consumes events now so they won't be piled up after the animation
         FS_Event fsEvt;
@@ -447,18 +602,29 @@ bool FliPlayer::play(bool intro, Font *pIntroFont) {
             pManager_->handleEvent(fsEvt);
         }
 
-        if (!decodeFrame())
+        uint32 deadline = startTime + frameIndex * frameLength;
+        uint32 now = g_System.getTicks();
+        bool show = now < deadline + frameLength;
+        if (!nextFrame(show))
             break;
-        copyCurrentFrameToScreen();
-
-        cur_frame++;
+        frameIndex++;
 
-        g_System.updateScreen();
-        g_System.delay(1000 / (intro ? 10 : 15));      //fps
+        if (show) {
+            now = g_System.getTicks();
+            if (now < deadline) {
+                g_System.delay(deadline - now);
+            }
+            g_System.updateScreen();
+        }
     }
 
-    //clear the backscreen
-    //bzero(Screen::pixels(), GAME_SCREEN_WIDTH * GAME_SCREEN_HEIGHT);
+    // let the last frame be displayed for its duration
+    uint32 endTime = startTime + frameIndex * frameLength;
+    uint32 now = g_System.getTicks();
+    if (now < endTime) {
+        g_System.delay(endTime - now);
+    }
 
+    stop();
     return true;
 }
@@ -223,6 +223,11 @@ void MenuManager::changeCurrentMenu()
         return;
     }
 
+    // Opening animation is loaded while the leaving animation is played
+    if (pMenu->hasShowAnim()) {
+        File::prefetchOriginalFile(pMenu->getShowAnimName());
+    }
+
     if (current_) {
         // Give the possibility to the old menu
         // to clean before leaving
@@ -240,6 +245,11 @@ void MenuManager::changeCurrentMenu()
 
 void MenuManager::gotoMenu(int menuId) {
     nextMenuId_ = menuId;
+    // Starts loading the animation of the next menu if it is already created
+    std::map<int, Menu *>::iterator it = menus_.find(menuId);
+    if (it != menus_.end() && it->second->hasShowAnim()) {
+        File::prefetchOriginalFile(it->second->getShowAnimName());
+    }
     // stop listening for events until window changed
     drop_events_ = true;
 }
@@ -280,6 +290,11 @@ void MenuManager::showMenu(Menu *pMenu) {
     // Adds a dirty rect to force menu rendering
     addRect(0, 0, g_Screen.gameScreenWidth(), g_Screen.gameScreenHeight());
 
+    // The leaving animation is loaded while menu is displayed
+    if (pMenu->hasLeaveAnim()) {
+        File::prefetchOriginalFile(pMenu->getLeaveAnimName());
+    }
+
     // reopen the event processing
     drop_events_ = false;
 }
@@ -330,8 +345,13 @@ void MenuManager::blitFromBackground(int x, int y, int width, int height) {
 /*!
  * Renders the current menu if there is one
  * and if it needs to be refreshed.
+ * \param alpha Part of the simulation step elapsed since the last tick
  */
-void MenuManager::renderMenu() {
+void MenuManager::renderMenu(float alpha) {
+    if (current_ && current_->isInterpolating()) {
+        current_->handleInterpolation(alpha);
+    }
+
     if (current_ && !dirtyList_.isEmpty()) {
         if (needBackground_) {
             for (int i=0; i < dirtyList_.getSize(); i++) {
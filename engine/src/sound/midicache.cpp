@@ -0,0 +1,173 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include "fs-engine/sound/midicache.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <cctype>
+
+#include "fs-utils/crc/ccrc32.h"
+#include "fs-utils/io/file.h"
+#include "fs-utils/log/log.h"
+
+const uint32 MidiCache::kVersion = 1;
+
+namespace {
+    const char kMagic[4] = {'F', 'S', 'M', 'C'};
+    //! A track is never bigger than that
+    const uint32 kMaxTrackSize = 4 * 1024 * 1024;
+}
+
+bool MidiCache::cacheFilePath(const std::string &xmiName, std::string &path) {
+    std::string filename(xmiName);
+    std::transform(filename.begin(), filename.end(), filename.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    filename.append(".mid");
+
+    fs::path fullPath;
+    if (!File::getCacheFullPath(filename, fullPath)) {
+        return false;
+    }
+    path.assign(fullPath.string());
+    return true;
+}
+
+uint32 MidiCache::tracksChecksum(const std::vector<std::vector<uint8>> &tracks) {
+    CCRC32 crc32;
+    unsigned int crc = 0xffffffff;
+    for (const std::vector<uint8> &track : tracks) {
+        crc32.PartialCRC(&crc, track.data(), track.size());
+    }
+    return crc ^ 0xffffffff;
+}
+
+/*!
+ * \param xmiName Name of the original XMI file
+ * \param xmiCrc Checksum of the content of the XMI file
+ * \param tracks Receives the MIDI data of each track
+ * \return False if there is no valid file for this XMI content. In that
+ * case, tracks is empty.
+ */
+bool MidiCache::load(const std::string &xmiName, uint32 xmiCrc,
+        std::vector<std::vector<uint8>> &tracks) {
+    tracks.clear();
+
+    std::string path;
+    if (!cacheFilePath(xmiName, path)) {
+        return false;
+    }
+
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (fp == NULL) {
+        return false;
+    }
+
+    Header header;
+    bool loaded = fread(&header, sizeof(Header), 1, fp) == 1
+        && memcmp(header.magic, kMagic, sizeof(kMagic)) == 0
+        && header.version == kVersion
+        && header.xmiCrc == xmiCrc
+        && header.nbTracks > 0 && header.nbTracks < 256;
+
+    std::vector<uint32> sizes;
+    if (loaded) {
+        sizes.resize(header.nbTracks);
+        loaded = fread(sizes.data(), sizeof(uint32), sizes.size(), fp) == sizes.size();
+    }
+
+    for (size_t i = 0; loaded && i < sizes.size(); i++) {
+        loaded = sizes[i] <= kMaxTrackSize;
+        if (loaded) {
+            tracks.emplace_back(sizes[i]);
+            loaded = sizes[i] == 0 || fread(tracks.back().data(), sizes[i], 1, fp) == 1;
+        }
+    }
+    fclose(fp);
+
+    if (loaded && tracksChecksum(tracks) != header.dataCrc) {
+        FSERR(Log::k_FLG_IO, "MidiCache", "load", ("Corrupted cache file %s\n", path.c_str()));
+        loaded = false;
+    }
+
+    if (!loaded) {
+        tracks.clear();
+    }
+    return loaded;
+}
+
+/*!
+ * The file is first written with a temporary name and then renamed, so
+ * an interrupted save does not leave a partial file.
+ * \param xmiName Name of the original XMI file
+ * \param xmiCrc Checksum of the content of the XMI file
+ * \param tracks MIDI data of each track
+ * \return True if file was saved
+ */
+bool MidiCache::save(const std::string &xmiName, uint32 xmiCrc,
+        const std::vector<std::vector<uint8>> &tracks) {
+    std::string path;
+    if (!cacheFilePath(xmiName, path)) {
+        return false;
+    }
+    std::string tmpPath = path + ".tmp";
+
+    FILE *fp = fopen(tmpPath.c_str(), "wb");
+    if (fp == NULL) {
+        FSERR(Log::k_FLG_IO, "MidiCache", "save", ("Cannot create cache file %s\n", tmpPath.c_str()));
+        return false;
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(Header));
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.xmiCrc = xmiCrc;
+    header.nbTracks = static_cast<uint32>(tracks.size());
+    header.dataCrc = tracksChecksum(tracks);
+
+    std::vector<uint32> sizes;
+    for (const std::vector<uint8> &track : tracks) {
+        sizes.push_back(static_cast<uint32>(track.size()));
+    }
+
+    bool saved = fwrite(&header, sizeof(Header), 1, fp) == 1
+        && fwrite(sizes.data(), sizeof(uint32), sizes.size(), fp) == sizes.size();
+    for (size_t i = 0; saved && i < tracks.size(); i++) {
+        saved = tracks[i].empty() || fwrite(tracks[i].data(), tracks[i].size(), 1, fp) == 1;
+    }
+    saved = (fclose(fp) == 0) && saved;
+
+    std::error_code ec;
+    if (saved) {
+        fs::rename(tmpPath, path, ec);
+        saved = !ec;
+    }
+    if (!saved) {
+        FSERR(Log::k_FLG_IO, "MidiCache", "save", ("Cannot write cache file %s\n", path.c_str()));
+        fs::remove(tmpPath, ec);
+    }
+
+    return saved;
+}
@@ -83,15 +83,26 @@ void SdlMixerMusic::stop() const
 }
 
 /*!
- * Stops the music with a fadeout.
+ * Starts a fade out of the music. The mixer stops the music at
+ * the end of the fade : use isPlaying() to know when it's done.
  * \param ms The length in milliseconds of the fade out.
  */
 void SdlMixerMusic::stopFadeOut(int ms) const
 {
-    while (!Mix_FadeOutMusic(ms) && Mix_PlayingMusic()) {
-        SDL_Delay(100);
+    if (!Mix_FadeOutMusic(ms)) {
+        // Music was not playing or is already fading out
+        if (Mix_FadingMusic() != MIX_FADING_OUT) {
+            Mix_HaltMusic();
+        }
     }
-    Mix_RewindMusic();
+}
+
+/*!
+ * Returns true while the music is playing, including during a fade out.
+ */
+bool SdlMixerMusic::isPlaying() const
+{
+    return Mix_PlayingMusic() != 0;
 }
 
 /*!
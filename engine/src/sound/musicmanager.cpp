@@ -27,10 +27,17 @@
 #include "fs-engine/sound/musicmanager.h"
 
 #include "fs-engine/sound/audio.h"
+#include "fs-engine/sound/midicache.h"
 #include "fs-engine/sound/xmidi.h"
+#include "fs-utils/crc/ccrc32.h"
 #include "fs-utils/io/file.h"
 #include "fs-utils/log/log.h"
 
+const int MusicManager::kFadeOutMs = 500;
+const int MusicManager::kFadeInMs = 300;
+const int MusicManager::kFadeOutTimeout = 2000;
+const size_t MusicManager::kNbTracks = msc::NB_TRACKS;
+
 MusicManager::MusicManager()
 {
     // -1 means music is not mute
@@ -38,7 +45,11 @@ MusicManager::MusicManager()
     volumeBeforeMute_ = -1;
     audio_ = NULL;
     disabled_ = false;
-    is_playing_ = false;
+    current_track_ = msc::NO_TRACK;
+    state_ = kStateStopped;
+    next_track_ = msc::NO_TRACK;
+    next_loops_ = -1;
+    fadeElapsed_ = 0;
 }
 
 MusicManager::~MusicManager()
@@ -49,77 +60,196 @@ bool MusicManager::isAudioInitialized() {
     return audio_ != NULL && audio_->isInitialized();
 }
 
+/*!
+ * Only saves the parameters : tracks are loaded the first time they're played.
+ */
 void MusicManager::initialize(bool disabled, Audio* audio)
 {
-    LOG(Log::k_FLG_SND, "MusicManager", "initialize", ("Loading music..."))
     audio_ = audio;
     disabled_ = disabled;
     if (disabled_) {
         FSINFO(Log::k_FLG_SND, "MusicManager", "initialize", ("Music will be disabled\n"))
     }
-    // If audio has not been initialized -> do nothing
-    if (!isAudioInitialized()) {
-        return;
-    }
 
-    XMidi xmidi;
-    std::vector < XMidi::Midi > tracks;
-    size_t size;
-    uint8 *data;
+    tracks_.clear();
+    tracks_.resize(kNbTracks);
+    midiData_.clear();
+    midiData_.resize(kNbTracks);
+}
+
+/*!
+ * Creates the music for the given track if it's not already done.
+ * \param track The track to load
+ * \return False if the track could not be loaded
+ */
+bool MusicManager::loadTrack(msc::MusicTrack track) {
+    if (tracks_.at(track)) {
+        return true;
+    }
 
-    LOG(Log::k_FLG_SND, "MusicManager", "initialize", ("Loading music for intro"))
+    std::unique_ptr<Music> music = audio_->createMusic();
 #if USE_INTRO_OGG
-    tracks_.push_back(audio->createMusic());
-    tracks_.back()->loadMusicFile("music/intro.ogg");
-#else
-    data = File::loadOriginalFile("INTRO.XMI", size);
-    tracks = xmidi.convertXMidi(data, size);
-    for (unsigned int i = 0; i < tracks.size(); ++i) {
-        tracks_.push_back(audio->createMusic());
-        tracks_.back()->loadMusic(tracks[i].data_, tracks[i].size_);
+    if (track == msc::TRACK_INTRO) {
+        LOG(Log::k_FLG_SND, "MusicManager", "loadTrack", ("Loading music for intro"))
+        if (!music->loadMusicFile("music/intro.ogg")) {
+            return false;
+        }
+        tracks_[track] = std::move(music);
+        return true;
     }
-    delete[] data;
 #endif
-
-    data = File::loadOriginalFile("SYNGAME.XMI", size);
-    tracks = xmidi.convertXMidi(data, size);
-    for (unsigned int i = 0; i < tracks.size(); ++i) {
-        LOG(Log::k_FLG_SND, "MusicManager", "initialize", ("Loading music for game : %i", i))
-        if (i == 0) {
 #if USE_ASSASSINATE_OGG
-            tracks_.push_back(audio->createMusic());
-            tracks_.back()->loadMusicFile("music/assassinate.ogg");
-#else
-            tracks_.push_back(audio->createMusic());
-            tracks_.back()->loadMusic(tracks[i].data_, tracks[i].size_);
+    if (track == msc::TRACK_ASSASSINATE) {
+        LOG(Log::k_FLG_SND, "MusicManager", "loadTrack", ("Loading music for assassinate"))
+        if (!music->loadMusicFile("music/assassinate.ogg")) {
+            return false;
+        }
+        tracks_[track] = std::move(music);
+        return true;
+    }
 #endif
+
+    if (midiData_[track].empty()) {
+        // Intro has its own file and all other tracks are in the game file
+        if (track == msc::TRACK_INTRO) {
+            convertMidiFile("INTRO.XMI", msc::TRACK_INTRO);
         } else {
-            tracks_.push_back(audio->createMusic());
-            tracks_.back()->loadMusic(tracks[i].data_, tracks[i].size_);
+            convertMidiFile("SYNGAME.XMI", msc::TRACK_ASSASSINATE);
+        }
+    }
+
+    std::vector<uint8> &midi = midiData_[track];
+    LOG(Log::k_FLG_SND, "MusicManager", "loadTrack", ("Loading music for track %d", track))
+    if (midi.empty() || !music->loadMusic(midi.data(), static_cast<int>(midi.size()))) {
+        return false;
+    }
+    tracks_[track] = std::move(music);
+    return true;
+}
+
+/*!
+ * Fills the MIDI data of all tracks of an original XMI file. The
+ * converted tracks are read from the cache if the file has already been
+ * converted, else they are converted and saved in the cache.
+ * Only empty tracks are filled : a loaded music keeps reading its data.
+ * \param filename Name of the XMI file
+ * \param firstTrack Track that matches the first track of the file
+ */
+void MusicManager::convertMidiFile(const char *filename, msc::MusicTrack firstTrack) {
+    size_t size;
+    uint8 *data = File::loadOriginalFile(filename, size);
+    if (data == NULL) {
+        return;
+    }
+
+    CCRC32 crc32;
+    uint32 xmiCrc = crc32.FullCRC(data, size);
+    std::vector<std::vector<uint8>> tracks;
+    if (!MidiCache::load(filename, xmiCrc, tracks)) {
+        LOG(Log::k_FLG_SND, "MusicManager", "convertMidiFile", ("Converting music file %s", filename))
+        XMidi xmidi;
+        std::vector<XMidi::Midi> midi = xmidi.convertXMidi(data, static_cast<int>(size));
+        for (XMidi::Midi &track : midi) {
+            if (track.size_ > 0) {
+                tracks.emplace_back(track.data_, track.data_ + track.size_);
+                delete[] track.data_;
+            } else {
+                tracks.emplace_back();
+            }
+        }
+
+        if (!tracks.empty()) {
+            MidiCache::save(filename, xmiCrc, tracks);
         }
     }
     delete[] data;
 
-    LOG(Log::k_FLG_SND, "MusicManager", "initialize", ("Music initialized"))
+    size_t first = static_cast<size_t>(firstTrack);
+    for (size_t i = 0; i < tracks.size() && first + i < midiData_.size(); i++) {
+        if (midiData_[first + i].empty()) {
+            midiData_[first + i].swap(tracks[i]);
+        }
+    }
 }
 
+/*!
+ * Plays the given track. If a track is already playing, it is faded out
+ * and the new track will start in a following call to update().
+ * \param track The track to play
+ * \param loops Number of times the track is played, -1 for ever
+ */
 void MusicManager::playTrack(msc::MusicTrack track, int loops)
 {
-    if (!disabled_ && isAudioInitialized()) {
-        if (is_playing_) {
-            tracks_.at(current_track_)->stopFadeOut();
-        }
-        tracks_.at(track)->play(loops);
-        current_track_ = track;
-        is_playing_ = true;
+    if (disabled_ || !isAudioInitialized()) {
+        return;
+    }
+
+    if (!loadTrack(track)) {
+        FSERR(Log::k_FLG_SND, "MusicManager", "playTrack", ("Cannot load music track %d\n", track));
+        return;
+    }
+
+    next_track_ = track;
+    next_loops_ = loops;
+
+    switch (state_) {
+    case kStatePlaying:
+        tracks_.at(current_track_)->stopFadeOut(kFadeOutMs);
+        state_ = kStateFadingOut;
+        fadeElapsed_ = 0;
+        break;
+    case kStateFadingOut:
+        // the fade out goes on and the new track replaces the queued one
+        break;
+    default:
+        startQueuedTrack();
+        break;
     }
 }
 
 void MusicManager::stopPlayback() {
-    if (!disabled_ && isAudioInitialized() && is_playing_) {
+    if (!disabled_ && isAudioInitialized() && state_ != kStateStopped) {
+        tracks_.at(current_track_)->stop();
+        state_ = kStateStopped;
+        next_track_ = msc::NO_TRACK;
+    }
+}
+
+/*!
+ * Starts the queued track when the fade out of the current track is over.
+ * \param elapsed Time in milliseconds since the last call
+ */
+void MusicManager::update(int elapsed) {
+    if (state_ != kStateFadingOut) {
+        return;
+    }
+
+    fadeElapsed_ += elapsed;
+    if (tracks_.at(current_track_)->isPlaying()) {
+        if (fadeElapsed_ < kFadeOutTimeout) {
+            return;
+        }
+        // mixer didn't end the fade : don't let the next track wait
         tracks_.at(current_track_)->stop();
-        is_playing_ = false;
     }
+
+    startQueuedTrack();
+}
+
+void MusicManager::startQueuedTrack() {
+    if (next_track_ == msc::NO_TRACK) {
+        state_ = kStateStopped;
+        return;
+    }
+
+    if (state_ == kStateFadingOut) {
+        tracks_.at(next_track_)->playFadeIn(next_loops_, kFadeInMs);
+    } else {
+        tracks_.at(next_track_)->play(next_loops_);
+    }
+    current_track_ = next_track_;
+    next_track_ = msc::NO_TRACK;
+    state_ = kStatePlaying;
 }
 
 void MusicManager::setVolume(int volume) {
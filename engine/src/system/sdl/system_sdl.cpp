@@ -46,6 +46,33 @@ SDL_Joystick *joy = NULL;
 
 const int SystemSDL::kCursorWidth = 24;
 
+namespace {
+    /*!
+     * Converts 8bpp palette indexed pixels to 32bpp pixels.
+     * Loop is unrolled as the lookups are independent from each other.
+     * \param src Indexed pixels
+     * \param dst Converted pixels
+     * \param count Number of pixels to convert
+     * \param lut 32 bits color for each index
+     */
+    void convertPixels(const uint8 *src, Uint32 *dst, size_t count, const Uint32 *lut) {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            dst[i] = lut[src[i]];
+            dst[i + 1] = lut[src[i + 1]];
+            dst[i + 2] = lut[src[i + 2]];
+            dst[i + 3] = lut[src[i + 3]];
+            dst[i + 4] = lut[src[i + 4]];
+            dst[i + 5] = lut[src[i + 5]];
+            dst[i + 6] = lut[src[i + 6]];
+            dst[i + 7] = lut[src[i + 7]];
+        }
+        for (; i < count; i++) {
+            dst[i] = lut[src[i]];
+        }
+    }
+}
+
 SystemSDL::SystemSDL() {
     keyModState_ = 0;
 
@@ -56,6 +83,10 @@ SystemSDL::SystemSDL() {
     pScreenTexture_ = nullptr;
 
     pixels_ = new Uint32[Screen::kScreenWidth * Screen::kScreenHeight];
+    for (int i = 0; i < 256; i++) {
+        paletteLut_[i] = 0xFF000000;
+    }
+    paletteChanged_ = true;
 }
 
 SystemSDL::~SystemSDL() {
@@ -130,6 +161,7 @@ bool SystemSDL::initialize(bool fullscreen) {
         FSERR(Log::k_FLG_GAME, "SystemSDL", "initialize", ("Critical error, Screen surface could not be created! SDL Error : %s", SDL_GetError()))
         return false;
     }
+    updatePaletteLut(0, pScreenSurface_->format->palette->ncolors);
 
     pScreenTexture_ = SDL_CreateTexture(pRenderer_,
                                             SDL_PIXELFORMAT_ARGB8888,
@@ -197,36 +229,29 @@ SDL_Window * SystemSDL::createWindow(bool fullscreen) {
 }
 
 void SystemSDL::updateScreen() {
-    if (g_Screen.dirty()|| (cursor_visible_ && update_cursor_)) {
+    bool screenChanged = g_Screen.dirty() || paletteChanged_;
+    if (screenChanged || (cursor_visible_ && update_cursor_)) {
         // Clear screen buffer
         SDL_RenderClear(pRenderer_);
 
-        SDL_LockSurface(pScreenSurface_);
-
-        const uint8 *srcPixels = g_Screen.pixels();
-
-        // We do manual blitting to convert from 8bpp palette indexed values to 32bpp RGB for each pixel
-        // thanks to bni (https://github.com/bni/freesynd)
-        uint8 r, g, b;
-        for (int i = 0; i < Screen::kScreenWidth * Screen::kScreenHeight; i++) {
-            uint8 index = srcPixels[i];
+        if (screenChanged) {
+            // When palette has changed, every pixel must be converted
+            int top = paletteChanged_ ? 0 : g_Screen.dirtyTop();
+            int bottom = paletteChanged_ ? Screen::kScreenHeight : g_Screen.dirtyBottom();
+            size_t first = static_cast<size_t>(top * Screen::kScreenWidth);
 
-            r = pScreenSurface_->format->palette->colors[index].r;
-            g = pScreenSurface_->format->palette->colors[index].g;
-            b = pScreenSurface_->format->palette->colors[index].b;
+            // We do manual blitting to convert from 8bpp palette indexed values to 32bpp RGB for each pixel
+            // thanks to bni (https://github.com/bni/freesynd)
+            convertPixels(g_Screen.pixels() + first, pixels_ + first,
+                    static_cast<size_t>((bottom - top) * Screen::kScreenWidth), paletteLut_);
 
-            Uint32 c = ((r << 16) | (g << 8) | (b << 0)) | (255 << 24);
+            // Copy the modified rows to the texture : the texture keeps the other rows
+            SDL_Rect rows = {0, top, Screen::kScreenWidth, bottom - top};
+            SDL_UpdateTexture(pScreenTexture_, &rows, pixels_ + first, Screen::kScreenWidth * static_cast<int>(sizeof(Uint32)));
 
-            // TODO : try to use pScreenSurface directly
-            pixels_[i] = c;
+            g_Screen.clearDirty();
+            paletteChanged_ = false;
         }
-        //memcpy (pScreenSurface_->pixels, srcPixels, Screen::kScreenWidth * Screen::kScreenHeight);
-
-        SDL_UnlockSurface(pScreenSurface_);
-
-        // Copy the pixel to the texture
-        //SDL_UpdateTexture(pScreenTexture_, NULL, pScreenSurface_->pixels, pScreenSurface_->pitch);
-        SDL_UpdateTexture(pScreenTexture_, NULL, pixels_, Screen::kScreenWidth * sizeof(Uint32));
 
         // Copy texture to the screen buffer
         SDL_RenderCopy(pRenderer_, pScreenTexture_, NULL, NULL);
@@ -247,6 +272,23 @@ void SystemSDL::updateScreen() {
     }
 }
 
+/*!
+ * The table is built from the palette of the screen surface so it must be
+ * called each time the palette of the surface is modified.
+ * \param first First index to update
+ * \param count Number of indexes to update
+ */
+void SystemSDL::updatePaletteLut(int first, int count) {
+    const SDL_Color *colors = pScreenSurface_->format->palette->colors;
+    for (int i = first; i < first + count && i < 256; i++) {
+        paletteLut_[i] = (static_cast<Uint32>(colors[i].r) << 16)
+            | (static_cast<Uint32>(colors[i].g) << 8)
+            | static_cast<Uint32>(colors[i].b)
+            | 0xFF000000;
+    }
+    paletteChanged_ = true;
+}
+
 /*!
  * Using the keysym parameter, verify if the given key is a function key (ie
  * a not printable key) returns the corresponding entry in the KeyFunc enumeration.
@@ -450,6 +492,7 @@ bool SystemSDL::setPalette6b3(const uint8 * pal, int cols) {
         FSERR(Log::k_FLG_GFX, "SystemSDL", "setPalette6b3", ("Could not set palette6b3 with %i colors! SDL Error : %s", cols, SDL_GetError()))
         return false;
     }
+    updatePaletteLut(0, cols);
     return true;
 }
 
@@ -466,6 +509,7 @@ bool SystemSDL::setPalette8b3(const uint8 * pal, int cols) {
         FSERR(Log::k_FLG_GFX, "SystemSDL", "setPalette6b3", ("Could not set palette8b3 with %i colors! SDL Error : %s", cols, SDL_GetError()))
         return false;
     }
+    updatePaletteLut(0, cols);
     return true;
 }
 
@@ -476,7 +520,9 @@ void SystemSDL::setColor(uint8 index, uint8 r, uint8 g, uint8 b) {
     color.g = g;
     color.b = b;
 
-    SDL_SetPaletteColors(pScreenSurface_->format->palette, &color, index, 1);
+    if (SDL_SetPaletteColors(pScreenSurface_->format->palette, &color, index, 1) == 0) {
+        updatePaletteLut(index, 1);
+    }
 }
 
 /*!
@@ -41,6 +41,9 @@
  *    Uint32 array that matches the display format and this array is then copied
  *    to an SDL Texture. This texture is then copied on the back buffer before
  *    presenting the scree.
+ *    The conversion uses a table of the 32 bits colors of the palette that is
+ *    updated when the palette changes, and only the rows that have been
+ *    modified on the Screen are converted and copied to the texture.
  *  - Mouse Cursor
  *    In order to display colorfull cursors, the SDL cursor display is disabled
  *    and is manually managed by this class with a SDL_Texture.
@@ -102,6 +105,8 @@ protected:
 
     //! Sets the key arguments with some key codes
     void fillKeyEvent(SDL_Keysym sym, FS_Event &evtOut);
+    //! Updates the palette table with the colors of the screen surface
+    void updatePaletteLut(int first, int count);
 
 protected:
     /*! A constant that holds the cursor icon width and height.*/
@@ -126,6 +131,15 @@ protected:
      * This array is used to transform the Screen::pixels that are uint8 into Uint32 pixels.
      */
     Uint32 *pixels_;
+    /*!
+     * The 32 bits ARGB value of each index of the palette.
+     */
+    Uint32 paletteLut_[256];
+    /*!
+     * True when the palette has changed since the last screen update : all
+     * the screen must then be converted again.
+     */
+    bool paletteChanged_;
     /*!
      * This surface is only used to store the current palette. It should replace completely
      * the pixels_ array.
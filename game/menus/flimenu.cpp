@@ -139,6 +139,7 @@ FliMenu::FliMenu(MenuManager *m, int menuId) : Menu(m, menuId, fs_game_menus::kM
 
 FliMenu::~FliMenu()
 {
+    fliPlayer_.stop();
     if (pData_) {
         delete[] pData_;
         pData_ = NULL;
@@ -177,6 +178,8 @@ bool FliMenu::loadNextFli() {
     if ( fliIndex_ < fliList_.size()) {
         size_t size = 0;
 
+        // the player must not read the data that is deleted
+        fliPlayer_.stop();
         if (pData_) {
             delete[] pData_;
             pData_ = NULL;
@@ -195,6 +198,10 @@ bool FliMenu::loadNextFli() {
                 frameIndex_ = 0;
                 currSubTitle_.erase();
                 fliIndex_++;
+                // next animation is loaded while this one is playing
+                if (fliIndex_ < fliList_.size()) {
+                    File::prefetchOriginalFile(fliList_.at(fliIndex_).name);
+                }
                 return true;
             }
         }
@@ -218,19 +225,21 @@ void FliMenu::handleTick(int elapsed)
         FliDesc desc = fliList_.at(fliIndex_ - 1);
         // There is a frame to display
         frameDelay_ += elapsed;
-        if (frameDelay_ > desc.frameDelay) {
+        // When ticks are longer than the frame delay, several frames are
+        // played at once but only the last one is displayed
+        while (frameDelay_ >= desc.frameDelay && fliPlayer_.hasFrames()) {
+            // Keep the time in excess so the animation does not drift
+            frameDelay_ -= desc.frameDelay;
+            bool show = frameDelay_ < desc.frameDelay;
             // read frame
-            if (!fliPlayer_.decodeFrame()) {
+            if (!fliPlayer_.nextFrame(show)) {
                 // Frame is not good -> quit
                 menu_manager_->gotoMenu(nextMenu_);
                 return;
             }
 
-            fliPlayer_.copyCurrentFrameToScreen();
             // Add a dirty rect just to start the render routine
             addDirtyRect(0, 0, 1, 1);
-            // Reset delay between frames
-            frameDelay_ = 0;
 
             // handle events
             for (uint16 i = 0; desc.evtList[i].frame != (uint16)-1; i++) {
@@ -316,6 +325,7 @@ bool FliMenu::handleUnMappedKey(const FS_Key key) {
 
 void FliMenu::handleLeave()
 {
+    fliPlayer_.stop();
     if (pData_) {
         delete[] pData_;
         pData_ = NULL;
@@ -30,6 +30,7 @@
 
 #include <stdio.h>
 #include <assert.h>
+#include <algorithm>
 
 #include "fs-engine/sound/musicmanager.h"
 #include "menus/gamemenuid.h"
@@ -50,6 +51,7 @@ const int SCROLL_STEP = 16;
 
 const int GameplayMenu::kMiniMapScreenX = 0;
 const int GameplayMenu::kMiniMapScreenY = 46 + 44 + 10 + 46 + 44 + 15 + 2 * 32 + 2;
+const int GameplayMenu::kAnimationStep = 33;
 
 //#define ANIM_PLUS_FRAME_VIEW
 
@@ -359,39 +361,10 @@ void GameplayMenu::handleTick(int elapsed)
         scroll_y_ = 0;
     }
 
-    if (tick_count_ - last_animate_tick_ > 33) {
+    if (tick_count_ - last_animate_tick_ >= kAnimationStep) {
         int diff = tick_count_ - last_animate_tick_;
         last_animate_tick_ = tick_count_;
-
-        for (size_t i = 0; i < mission_->numSfxObjects(); i++) {
-            SFXObject *pSfx = mission_->sfxObjects(i);
-            change |= pSfx->animate(diff);
-            if (pSfx->sfxLifeOver()) {
-                mission_->delSfxObject(i);
-                i--;
-            }
-        }
-
-        for (size_t i = 0; i < mission_->numPeds(); i++)
-            change |= mission_->ped(i)->animate(diff, mission_);
-
-
-        for (size_t i = 0; i < mission_->numVehicles(); i++)
-            change |= mission_->vehicle(i)->animate(diff);
-
-        for (size_t i = 0; i < mission_->numWeaponsOnGround(); i++)
-            change |= mission_->weaponOnGround(i)->animate(diff);
-
-        for (size_t i = 0; i < mission_->numStatics(); i++)
-            change |= mission_->statics(i)->animate(diff);
-
-        for (size_t i = 0; i < mission_->numPrjShots(); i++) {
-            change |= mission_->prjShots(i)->animate(diff, mission_);
-            if (mission_->prjShots(i)->isLifeOver()) {
-                mission_->delPrjShot(i);
-                i--;
-            }
-        }
+        change |= mission_->animate(diff);
 
         updateMarkersPosition();
     }
@@ -409,6 +382,20 @@ void GameplayMenu::handleTick(int elapsed)
     drawMissionHint(elapsed);
 }
 
+bool GameplayMenu::isInterpolating() {
+    return mission_ != NULL && !paused_ && mission_->hasObjectsMoved();
+}
+
+/*!
+ * Peds and vehicles are drawn between the position they had before the
+ * last tick and their current position.
+ * \param alpha Part of the simulation step elapsed since the last tick
+ */
+void GameplayMenu::handleInterpolation(float alpha) {
+    map_renderer_.setInterpolation(alpha);
+    needRendering();
+}
+
 void GameplayMenu::handleRender(DirtyList &dirtyList)
 {
     g_Screen.clear(0);
@@ -552,14 +539,48 @@ void GameplayMenu::handleMouseMotion(int x, int y, int state, const int modKeys)
     bool inrange = false;
     target_ = NULL;
 
-    if (x > 128) {
-#ifdef _DEBUG
-        // During debug our agents are included in possible targets
-        for (size_t i = 0; mission_ && i < mission_->numPeds(); ++i) {
-#else
-        for (size_t i = mission_->getSquad()->size(); mission_ && i < mission_->numPeds(); ++i) {
+    if (x > 128 && mission_) {
+        // Position of the mouse on the map
+        int mx = x - 129 + displayOriginPt_.x;
+        int my = y + displayOriginPt_.y;
+        // Objects are drawn above their tile depending on their height
+        // so look at tiles under the mouse down to the lowest level
+        int maxDrawHeight = (mission_->get_map()->maxZ() + 1) * TILE_HEIGHT / 3 + 34;
+        TilePoint corners[4] = {
+            mission_->get_map()->screenToTilePoint(mx - 40, my - 34),
+            mission_->get_map()->screenToTilePoint(mx + 40, my - 34),
+            mission_->get_map()->screenToTilePoint(mx - 40, my + maxDrawHeight),
+            mission_->get_map()->screenToTilePoint(mx + 40, my + maxDrawHeight)
+        };
+        int minTx = corners[0].tx, maxTx = corners[0].tx;
+        int minTy = corners[0].ty, maxTy = corners[0].ty;
+        for (int i = 1; i < 4; i++) {
+            minTx = std::min(minTx, corners[i].tx);
+            maxTx = std::max(maxTx, corners[i].tx);
+            minTy = std::min(minTy, corners[i].ty);
+            maxTy = std::max(maxTy, corners[i].ty);
+        }
+        hoverCandidates_.clear();
+        mission_->getObjectGrid().findInTileArea(minTx, minTy, maxTx, maxTy,
+            MapObject::kNaturePed | MapObject::kNatureVehicle | MapObject::kNatureWeapon,
+            hoverCandidates_);
+
+        for (size_t i = 0; i < hoverCandidates_.size(); ++i) {
+            if (!hoverCandidates_[i]->is(MapObject::kNaturePed)) {
+                continue;
+            }
+            PedInstance *p = static_cast<PedInstance *>(hoverCandidates_[i]);
+#ifndef _DEBUG
+            // During debug our agents are included in possible targets
+            // squad agents are the first peds of the mission
+            bool isSquadMember = false;
+            for (size_t agent = 0; agent < mission_->getSquad()->size(); agent++) {
+                isSquadMember |= (mission_->ped(agent) == p);
+            }
+            if (isSquadMember) {
+                continue;
+            }
 #endif
-            PedInstance *p = mission_->ped(i);
             if (p->isAlive() && p->isDrawable()) {
                 Point2D scPt;
                 mission_->get_map()->tileToScreenPoint(p->position(), &scPt);
@@ -567,8 +588,7 @@ void GameplayMenu::handleMouseMotion(int x, int y, int state, const int modKeys)
                 int py = scPt.y - (1 + p->tileZ()) * TILE_HEIGHT/3
                     - (p->offZ() * TILE_HEIGHT/3) / 128;
 
-                if (x - 129 + displayOriginPt_.x >= px && y + displayOriginPt_.y >= py &&
-                    x - 129 + displayOriginPt_.x < px + 21 && y + displayOriginPt_.y < py + 34)
+                if (mx >= px && my >= py && mx < px + 21 && my < py + 34)
                 {
                     // mouse pointer is on the object, so it's the new target
                     target_ = p;
@@ -578,8 +598,11 @@ void GameplayMenu::handleMouseMotion(int x, int y, int state, const int modKeys)
             }
         }
 
-        for (size_t i = 0; mission_ && i < mission_->numVehicles(); ++i) {
-            Vehicle *v = mission_->vehicle(i);
+        for (size_t i = 0; i < hoverCandidates_.size(); ++i) {
+            if (!hoverCandidates_[i]->is(MapObject::kNatureVehicle)) {
+                continue;
+            }
+            Vehicle *v = static_cast<Vehicle *>(hoverCandidates_[i]);
             // TrainHead cannot be selected to prevent player from putting agents in it
             if (v->isAlive() && v->getType() != Vehicle::kVehicleTypeTrainHead) {
                 Point2D scPt;
@@ -587,8 +610,7 @@ void GameplayMenu::handleMouseMotion(int x, int y, int state, const int modKeys)
                 int px = scPt.x - 20;
                 int py = scPt.y - 10 - v->tileZ() * TILE_HEIGHT/3;
 
-                if (x - 129 + displayOriginPt_.x >= px && y + displayOriginPt_.y >= py &&
-                    x - 129 + displayOriginPt_.x < px + 40 && y + displayOriginPt_.y < py + 32)
+                if (mx >= px && my >= py && mx < px + 40 && my < py + 32)
                 {
                     target_ = v;
                     inrange = selection_.isTargetInRange(mission_, target_);
@@ -597,8 +619,11 @@ void GameplayMenu::handleMouseMotion(int x, int y, int state, const int modKeys)
             }
         }
 
-        for (size_t i = 0; mission_ && i < mission_->numWeaponsOnGround(); ++i) {
-            WeaponInstance *w = mission_->weaponOnGround(i);
+        for (size_t i = 0; i < hoverCandidates_.size(); ++i) {
+            if (!hoverCandidates_[i]->is(MapObject::kNatureWeapon)) {
+                continue;
+            }
+            WeaponInstance *w = static_cast<WeaponInstance *>(hoverCandidates_[i]);
 
             if (w->isDrawable()) {
                 Point2D scPt;
@@ -607,8 +632,7 @@ void GameplayMenu::handleMouseMotion(int x, int y, int state, const int modKeys)
                 int py = scPt.y + 4 - w->tileZ() * TILE_HEIGHT/3
                     - (w->offZ() * TILE_HEIGHT/3) / 128;
 
-                if (x - 129 + displayOriginPt_.x >= px && y + displayOriginPt_.y >= py &&
-                    x - 129 + displayOriginPt_.x < px + 20 && y + displayOriginPt_.y < py + 15)
+                if (mx >= px && my >= py && mx < px + 20 && my < py + 15)
                 {
                     target_ = w;
                     break;
@@ -48,6 +48,9 @@ public:
     void handleShow();
     void handleRender(DirtyList &dirtyList);
     void handleLeave();
+    //! Moving objects are drawn between two ticks
+    bool isInterpolating() override;
+    void handleInterpolation(float alpha) override;
 
 protected:
     /**
@@ -121,6 +124,8 @@ protected:
     static const int kMiniMapScreenX;
     /*! Origin of the minimap on the screen.*/
     static const int kMiniMapScreenY;
+    /*! Minimum time between two animations of the mission objects.*/
+    static const int kAnimationStep;
 
     int tick_count_, last_animate_tick_;
     int last_motion_tick_, last_motion_x_, last_motion_y_;
@@ -138,6 +143,8 @@ protected:
     SquadSelection selection_;
     /*! Object mouse cursor is above*/
     ShootableMapObject *target_;
+    /*! Objects of the mission grid around the mouse cursor.*/
+    std::vector<MapObject *> hoverCandidates_;
     /*! This renderer is in charge of drawing the map.*/
     MapRenderer map_renderer_;
     /*! This renderer is in charge of drawing the minimap.*/
@@ -27,6 +27,9 @@
 
 #include "menus/maprenderer.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "fs-engine/gfx/screen.h"
 #include "fs-engine/gfx/tile.h"
 #include "fs-engine/system/system.h"
@@ -143,45 +146,38 @@ int MapRenderer::tileHashKey(MapObject * m) {
 }
 
 void MapRenderer::listObjectsToDraw(const Point2D &viewport) {
-    /*if (tilex < 0)
-        tilex = 0;
-    if (tiley < 0)
-        tiley = 0;
-    if (maxtilex >= pMap_->maxX())
-        maxtilex = pMap_->maxX();
-    if (maxtiley >= pMap_->maxY())
-        maxtiley = pMap_->maxY();*/
-
-
-    // Include peds
-    for (size_t i = 0; i < pMission_->numPeds(); i++) {
-        PedInstance *pPed = pMission_->ped(i);
-        if (pPed->isDrawable() && isObjectInsideDrawingArea(pPed, viewport)) {
-            addObjectToDraw(pPed);
-        }
-    }
-
-    // vehicles
-    for (size_t i = 0; i < pMission_->numVehicles(); i++) {
-        Vehicle *pVehicle = pMission_->vehicle(i);
-        if (isObjectInsideDrawingArea(pVehicle, viewport)) {
-            addObjectToDraw(pVehicle);
-        }
+    // Tiles that are covered by the drawing area (see isObjectInsideDrawingArea())
+    int left = viewport.x - TILE_WIDTH / 2;
+    int right = viewport.x + Screen::kScreenWidth - Screen::kScreenPanelWidth + 10;
+    int top = viewport.y;
+    int bottom = viewport.y + Screen::kScreenHeight + pMap_->maxZ() * 48;
+    TilePoint corners[4] = {
+        pMap_->screenToTilePoint(left, top),
+        pMap_->screenToTilePoint(right, top),
+        pMap_->screenToTilePoint(left, bottom),
+        pMap_->screenToTilePoint(right, bottom)
+    };
+    int minTx = corners[0].tx, maxTx = corners[0].tx;
+    int minTy = corners[0].ty, maxTy = corners[0].ty;
+    for (int i = 1; i < 4; i++) {
+        minTx = std::min(minTx, corners[i].tx);
+        maxTx = std::max(maxTx, corners[i].tx);
+        minTy = std::min(minTy, corners[i].ty);
+        maxTy = std::max(maxTy, corners[i].ty);
     }
 
-    // weapons
-    for (size_t i = 0; i < pMission_->numWeaponsOnGround(); i++) {
-        WeaponInstance *pWeapon = pMission_->weaponOnGround(i);
-        if (pWeapon->isDrawable() && isObjectInsideDrawingArea(pWeapon, viewport)) {
-            addObjectToDraw(pWeapon);
-        }
-    }
-
-    // statics
-    for (size_t i = 0; i < pMission_->numStatics(); i++) {
-        Static *pStatic = pMission_->statics(i);
-        if (isObjectInsideDrawingArea(pStatic, viewport)) {
-            addObjectToDraw(pStatic);
+    // peds, vehicles, weapons and statics
+    candidates_.clear();
+    pMission_->getObjectGrid().findInTileArea(minTx, minTy, maxTx, maxTy,
+        MapObject::kNaturePed | MapObject::kNatureVehicle |
+        MapObject::kNatureWeapon | MapObject::kNatureStatic, candidates_);
+    for (size_t i = 0; i < candidates_.size(); i++) {
+        MapObject *pObject = candidates_[i];
+        // vehicles and statics are always drawn
+        bool drawable = pObject->isDrawable() ||
+            pObject->is(MapObject::kNatureVehicle) || pObject->is(MapObject::kNatureStatic);
+        if (drawable && isObjectInsideDrawingArea(pObject, viewport)) {
+            addObjectToDraw(pObject);
         }
     }
 
@@ -229,7 +225,9 @@ int MapRenderer::drawObjectsOnTile(const TilePoint & tilePos, const Point2D &scr
         ObjectToDraw *pObj = it->second;
         objectsByTile_.erase(it);
         while(pObj != NULL) {
-            pObj->getObject()->draw(screenPos);
+            Point2D objectScreenPos = screenPos;
+            addInterpolationOffset(pObj->getObject(), &objectScreenPos);
+            pObj->getObject()->draw(objectScreenPos);
             ObjectToDraw *pNext = pObj->getNext();
             pool_.releaseResource(pObj);
             pObj = pNext;
@@ -241,6 +239,42 @@ int MapRenderer::drawObjectsOnTile(const TilePoint & tilePos, const Point2D &scr
 }
 
 
+/**
+ * Moves the drawing position of a moving object back toward the position
+ * it had at the start of the last tick, so that it moves smoothly between
+ * two ticks.
+ * \param pObject MapObject* Object to draw
+ * \param pScreenPos Point2D* Drawing position for the current position
+ * \return void
+ *
+ */
+void MapRenderer::addInterpolationOffset(MapObject *pObject, Point2D *pScreenPos) {
+    // only peds and vehicles keep their previous position (see Mission::animate())
+    if (interpolation_ >= 1.0f
+        || !(pObject->is(MapObject::kNaturePed) || pObject->is(MapObject::kNatureVehicle))
+        || !pObject->hasMovedSinceLastTick()) {
+        return;
+    }
+
+    WorldPoint curPosW(pObject->position());
+    WorldPoint prevPosW(pObject->previousPosition());
+    if (abs(curPosW.x - prevPosW.x) > 256 || abs(curPosW.y - prevPosW.y) > 256
+        || abs(curPosW.z - prevPosW.z) > 128) {
+        // object has not walked but was put somewhere else
+        return;
+    }
+
+    Point2D curScreenPos, prevScreenPos;
+    pMap_->tileToScreenPoint(pObject->position(), &curScreenPos);
+    pMap_->tileToScreenPoint(pObject->previousPosition(), &prevScreenPos);
+    // tileToScreenPoint() ignores height
+    prevScreenPos.y -= (prevPosW.z - curPosW.z) * (TILE_HEIGHT / 3) / 128;
+
+    float back = 1.0f - interpolation_;
+    pScreenPos->x += static_cast<int>(static_cast<float>(prevScreenPos.x - curScreenPos.x) * back);
+    pScreenPos->y += static_cast<int>(static_cast<float>(prevScreenPos.y - curScreenPos.y) * back);
+}
+
 /**
  * Adds an object to the list of objects to draw for the tile it's on.
  * For a given tile object are sorted from back to front so that
@@ -145,10 +145,16 @@ private:
 
 class MapRenderer {
 public:
-    MapRenderer() : pool_(10) {}
+    MapRenderer() : pool_(10), interpolation_(1.0f) {}
 
     void init(Mission *pMission, SquadSelection *pSelection);
 
+    /*!
+     * Sets the part of the simulation step elapsed since the last tick.
+     * Moving objects are drawn between their previous and current position.
+     */
+    void setInterpolation(float alpha) { interpolation_ = alpha; }
+
     void render(const Point2D &worldPos);
 
 private:
@@ -169,6 +175,7 @@ private:
     bool isObjectInsideDrawingArea(MapObject *pObject, const Point2D &viewport);
     int drawObjectsOnTile(const TilePoint & tilePos, const Point2D &screenPos);
     void addObjectToDraw(MapObject *pObject);
+    void addInterpolationOffset(MapObject *pObject, Point2D *pScreenPos);
     void freeUnreleasedResources();
 
 private:
@@ -179,6 +186,10 @@ private:
     Pool<ObjectToDraw> pool_;
     /*! This map contains for each tile the list of objects to draw.*/
     std::map<int, ObjectToDraw *> objectsByTile_;
+    /*! Objects found in the mission grid around the screen.*/
+    std::vector<MapObject *> candidates_;
+    /*! Part of the simulation step elapsed since the last tick.*/
+    float interpolation_;
 };
 
 #endif  // MENUS_MAPRENDERER_H_
@@ -0,0 +1,91 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#ifndef IA_ACTIONPOOL_H_
+#define IA_ACTIONPOOL_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "fs-utils/common.h"
+
+/*!
+ * Memory pool for the actions of peds.
+ *
+ * Actions are small objects created for each order, pickup or hit and
+ * deleted when they finish, so their blocks are kept in free lists
+ * by size class instead of going back to the general allocator.
+ * Blocks are carved from chunks that are only released by trim().
+ * Bigger objects than kMaxBlockSize go directly to the heap.
+ *
+ * The pool is not thread safe : actions are created and deleted only
+ * in the update phase of the mission.
+ */
+class ActionPool {
+public:
+    //! Counters of the pool
+    struct Stats {
+        //! Number of blocks returned by allocate()
+        uint64 allocations;
+        //! Number of blocks taken from a free list
+        uint64 reuses;
+        //! Number of calls to the general allocator
+        uint64 heapAllocations;
+        //! Number of blocks currently allocated
+        uint64 inUse;
+        //! Number of bytes reserved in chunks
+        size_t bytesReserved;
+    };
+
+    //! Size of the biggest block managed by the pool
+    static const size_t kMaxBlockSize;
+
+    ActionPool();
+    ~ActionPool();
+
+    //! Returns a block of the given size
+    void *allocate(size_t size);
+    //! Gives back a block returned by allocate() with the same size
+    void release(void *p, size_t size);
+
+    //! Returns the counters
+    Stats stats() const { return stats_; }
+    //! Resets the counters except the ones about current usage
+    void resetStats();
+    //! Frees all chunks if no block is in use
+    bool trim();
+
+private:
+    //! A free block is linked to the next free block of the same class
+    struct FreeBlock {
+        FreeBlock *pNext;
+    };
+
+    //! Free blocks for each size class
+    std::vector<FreeBlock *> freeLists_;
+    //! Chunks allocated from the heap
+    std::vector<char *> chunks_;
+    Stats stats_;
+};
+
+#endif  // IA_ACTIONPOOL_H_
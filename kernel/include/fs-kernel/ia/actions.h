@@ -27,6 +27,7 @@
 #include "fs-utils/misc/timer.h"
 #include "fs-kernel/model/path.h"
 #include "fs-kernel/model/static.h"
+#include "fs-kernel/ia/actionpool.h"
 
 class Mission;
 class PedInstance;
@@ -112,6 +113,13 @@ public:
     //! Destructor of the class
     virtual ~Action() { }
 
+    //! Actions of all types are allocated in the pool
+    static void *operator new(size_t size) { return pool_.allocate(size); }
+    //! Gives the memory of the action back to the pool
+    static void operator delete(void *p, size_t size) { pool_.release(p, size); }
+    //! Returns the pool where actions are allocated
+    static ActionPool &pool() { return pool_; }
+
     //! Entry point to execute the action
     virtual bool execute(int elapsed, Mission *pMission, PedInstance *pPed) = 0;
 
@@ -146,6 +154,10 @@ protected:
     ActionSource source_;
     /*! This is the status of the action.*/
     ActionStatus status_;
+
+private:
+    //! Memory shared by all actions
+    static ActionPool pool_;
 };
 
 /*!
@@ -25,6 +25,7 @@
 #define IA_BEHAVIOUR_H_
 
 #include <list>
+#include <vector>
 
 #include "fs-utils/misc/timer.h"
 #include "fs-kernel/ia/actions.h"
@@ -73,6 +74,9 @@ public:
     //! Destroy existing components and set given one as new one
     void replaceAllcomponentsBy(BehaviourComponent *pComp);
 
+    //! Prepares the execution using only reads on the mission
+    void think(int elapsed, Mission *pMission);
+
     virtual void execute(int elapsed, Mission *pMission);
 
     virtual void handleBehaviourEvent(BehaviourEvent evtType, void *pCtxt = NULL);
@@ -85,6 +89,46 @@ protected:
     std::list <BehaviourComponent *> compLst_;
 };
 
+/*!
+ * Peds found around a ped during the think phase of a step.
+ * The search is done with a range increased by kMoveMargin, so
+ * the list still contains all the peds in range after other peds
+ * have moved during the update of the step. The list can only be used
+ * while the think stamp of the mission is the same as during the
+ * search (see Mission::thinkStamp()).
+ */
+class ScoutCandidates {
+public:
+    //! Added to the scout range for the moves done during one step
+    static const int kMoveMargin;
+
+    ScoutCandidates() { valid_ = false; stamp_ = 0; }
+
+    //! Empties the list and marks it as not valid
+    void clear() {
+        valid_ = false;
+        peds_.clear();
+    }
+    //! Adds a ped found by the search
+    void add(PedInstance *pPed) { peds_.push_back(pPed); }
+    //! Marks the list as complete for the given think stamp
+    void validate(uint32 stamp) {
+        valid_ = true;
+        stamp_ = stamp;
+    }
+    //! Returns true if the list can be used instead of a new search
+    bool isValid(uint32 stamp) const { return valid_ && stamp_ == stamp; }
+
+    size_t size() const { return peds_.size(); }
+    PedInstance *ped(size_t i) const { return peds_[i]; }
+
+private:
+    bool valid_;
+    //! Think stamp of the mission when the search was done
+    uint32 stamp_;
+    std::vector<PedInstance *> peds_;
+};
+
 /*!
  * Abstract class that represent an aspect of a behaviour.
  * A component may be disabled according to certain types of events.
@@ -97,6 +141,15 @@ public:
     bool isEnabled() { return enabled_; }
     void setEnabled(bool val) { enabled_ = val; }
 
+    /*!
+     * Called for all peds, possibly in parallel, before any ped is executed.
+     * A component can do here its searches but must not modify anything
+     * else than its own members. Only range scans are done here : line of
+     * sight and shooting line checks use workspaces of the mission, so they
+     * stay in execute().
+     */
+    virtual void think(int /*elapsed*/, Mission * /*pMission*/, PedInstance * /*pPed*/) {}
+
     virtual void execute(int elapsed, Mission *pMission, PedInstance *pPed) = 0;
 
     virtual void handleBehaviourEvent(PedInstance *pPed, Behaviour::BehaviourEvent evtType, void *pCtxt){};
@@ -134,13 +187,20 @@ class PersuaderBehaviourComponent : public BehaviourComponent {
 public:
     PersuaderBehaviourComponent();
 
+    void think(int elapsed, Mission *pMission, PedInstance *pPed);
+
     void execute(int elapsed, Mission *pMission, PedInstance *pPed);
 
     void handleBehaviourEvent(PedInstance *pPed, Behaviour::BehaviourEvent evtType, void *pCtxt);
+private:
+    //! Sends the persuasion to the other ped
+    void persuade(PedInstance *pPed, PedInstance *pOtherPed);
 private:
     /*! Flag to indicate an agent can use his persuadotron.*/
     bool doUsePersuadotron_;
     int persuadotronRange_;
+    //! Peds close enough to be persuaded
+    ScoutCandidates candidates_;
 };
 
 /*!
@@ -200,6 +260,8 @@ public:
 
     PanicComponent();
 
+    void think(int elapsed, Mission *pMission, PedInstance *pPed);
+
     void execute(int elapsed, Mission *pMission, PedInstance *pPed);
 
     void handleBehaviourEvent(PedInstance *pPed, Behaviour::BehaviourEvent evtType, void *pCtxt);
@@ -227,12 +289,16 @@ private:
     bool backFromPanic_;
     /*! The ped that frightened this civilian.*/
     PedInstance *pArmedPed_;
+    //! Armed peds that may be close to the civilian
+    ScoutCandidates candidates_;
 };
 
 class PoliceBehaviourComponent : public BehaviourComponent {
 public:
     PoliceBehaviourComponent();
 
+    void think(int elapsed, Mission *pMission, PedInstance *pPed);
+
     void execute(int elapsed, Mission *pMission, PedInstance *pPed);
 
     void handleBehaviourEvent(PedInstance *pPed, Behaviour::BehaviourEvent evtType, void *pCtxt);
@@ -271,6 +337,8 @@ private:
     fs_utils::Timer scoutTimer_;
     /*! The ped that the police officer is watching and eventually shooting at.*/
     PedInstance *pTarget_;
+    //! Armed peds that may be close to the police officer
+    ScoutCandidates candidates_;
 };
 
 /*!
@@ -280,6 +348,8 @@ class PlayerHostileBehaviourComponent : public BehaviourComponent {
 public:
     PlayerHostileBehaviourComponent();
 
+    void think(int elapsed, Mission *pMission, PedInstance *pPed);
+
     void execute(int elapsed, Mission *pMission, PedInstance *pPed);
 
     void handleBehaviourEvent(PedInstance *pPed, Behaviour::BehaviourEvent evtType, void *pCtxt);
@@ -308,6 +378,8 @@ private:
     PlayerHostileStatus status_;
     /*! The ped that the owner has targeted and potentially is shooting at.*/
     PedInstance *pTarget_;
+    //! Player agents that may be close to the ped
+    ScoutCandidates candidates_;
 };
 
 
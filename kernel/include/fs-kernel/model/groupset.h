@@ -0,0 +1,81 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#ifndef MODEL_GROUPSET_H_
+#define MODEL_GROUPSET_H_
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "fs-utils/common.h"
+
+/*!
+ * A set of group definitions (a group id and a group def) stored as
+ * bitmasks, so that tests done for each pair of peds are a few bit
+ * operations instead of searches in a multimap.
+ *
+ * Group ids are given an index (from 0 to kMaxGroups - 1) shared by all
+ * sets, so each set has one bit per group. A def of 0 means all defs of
+ * the group : other defs are kept in a list that is almost always empty.
+ * The set is rebuilt from the multimap each time the multimap changes.
+ * If there are more than kMaxGroups group ids, sets with an id that has
+ * no index are not exact and callers must use the multimap.
+ */
+class GroupSet {
+public:
+    //! Max number of group ids with an index
+    static const int kMaxGroups;
+    //! Index of a group id when all indexes are used
+    static const int kNoGroup;
+
+    //! Returns the index of the group id, creating it if needed
+    static int indexOf(uint32 groupId);
+
+    GroupSet();
+
+    //! Rebuilds the set with the (group id, group def) pairs
+    void set(const std::multimap<uint32, uint32> &defs);
+
+    //! Returns false if the set must not be used
+    bool isExact() const { return exact_; }
+    //! Returns true if the set has no group
+    bool empty() const { return groups_ == 0; }
+    //! Returns true if the group is in the set for that def (0 is any def)
+    bool contains(int groupIndex, uint32 groupDef) const;
+    //! Returns true if a group is in both sets
+    bool sharesGroupWith(const GroupSet &other) const {
+        return (groups_ & other.groups_) != 0;
+    }
+
+private:
+    //! Groups that are in the set
+    uint64 groups_;
+    //! Groups that are in the set for all defs
+    uint64 allDefs_;
+    //! Groups in the set for some defs only : (index, def)
+    std::vector< std::pair<int, uint32> > defs_;
+    bool exact_;
+};
+
+#endif  // MODEL_GROUPSET_H_
@@ -68,6 +68,11 @@ public:
     //! Return the object's id
     uint16 id() const { return id_; }
 
+    //! Return the cell of the mission's object grid where the object is
+    int gridCell() const { return gridCell_; }
+    //! Set by the object grid
+    void setGridCell(int cell) { gridCell_ = cell; }
+
     //! Set if MapObject is visible on screen
     void setDrawable(bool drawable) {
         isDrawable_ = drawable;
@@ -87,6 +92,16 @@ public:
 
     const TilePoint & position()const { return pos_; }
 
+    //! Returns the position the object had at the start of the last tick
+    const TilePoint & previousPosition() const { return prevPos_; }
+    //! Keeps the current position before the object moves for a new tick
+    void savePreviousPosition() { prevPos_.initFrom(pos_); }
+    //! Returns true if the object has moved since savePreviousPosition() was called
+    bool hasMovedSinceLastTick() const {
+        return pos_.tx != prevPos_.tx || pos_.ty != prevPos_.ty || pos_.tz != prevPos_.tz
+            || pos_.ox != prevPos_.ox || pos_.oy != prevPos_.oy || pos_.oz != prevPos_.oz;
+    }
+
     void setPosition(int tile_x, int tile_y, int tile_z, int off_x = 0,
             int off_y = 0, int off_z = 0) {
         pos_.tx = tile_x;
@@ -282,10 +297,14 @@ protected:
     ObjectNature nature_;
     //! Id of the object. Id is unique within a nature
     uint16 id_;
+    //! Cell of the object in the mission's grid (see MapObjectGrid)
+    int gridCell_;
     /*!
      * Tile based coordinates.
      */
     TilePoint pos_;
+    //! Position at the start of the last tick, used to draw between ticks
+    TilePoint prevPos_;
     //! these are not true sizes, but halfs of full size by respective coord
     int size_x_, size_y_, size_z_;
     //! A pointer to the map that the object is on
@@ -30,6 +30,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <memory>
 
 #include "fs-utils/common.h"
 #include "fs-kernel/model/static.h"
@@ -37,6 +38,11 @@
 #include "fs-kernel/model/map.h"
 #include "fs-kernel/model/leveldata.h"
 #include "fs-kernel/model/pathsurfaces.h"
+#include "fs-kernel/model/objectgrid.h"
+#include "fs-kernel/model/pathregions.h"
+#include "fs-kernel/model/roadpathfinder.h"
+#include "fs-kernel/model/visibility.h"
+#include "fs-kernel/model/simprofile.h"
 #include "fs-kernel/mgr/weaponmanager.h"
 
 class Vehicle;
@@ -46,6 +52,9 @@ class ObjectiveDesc;
 class Squad;
 class ProjectileShot;
 class GaussGunShot;
+namespace fs_utils {
+    class WorkerPool;
+}
 
 /*!
  * A class that holds mission statistics.
@@ -131,6 +140,10 @@ public:
     static const uint8 kBMaskBlockerTargetOutOfMap;
     static const uint8 kBMaskBlockerTargetObjectUpdated;
     static const uint8 kBMaskBlockerTargetPosUpdated;
+    //! Distance kept between a blocking tile and the position returned for it
+    static const double kTileCheckStep;
+    //! Min number of peds for each thread of the think phase
+    static const size_t kMinPedsForWorkers;
 
     Mission(const LevelData::MapInfos & map_infos, Map *pMap);
     virtual ~Mission();
@@ -156,6 +169,18 @@ public:
     //! Check if objectives are completed or failed
     void checkObjectives();
     void objectiveMsg(std::string& msg);
+    //! Animates all objects for one simulation step
+    bool animate(int elapsed, SimProfile *pProfile = NULL);
+    //! Returns true if a ped or a vehicle has moved during the last step
+    bool hasObjectsMoved() const { return objectsMoved_; }
+    //! Sets the number of threads that help for the think phase of peds
+    void setThinkWorkers(size_t nbWorkers);
+    /*!
+     * Returns a stamp that changes at each step and each time the list
+     * of armed peds changes. Results of the think phase are valid only
+     * while the stamp does not change.
+     */
+    uint32 thinkStamp() const { return thinkStamp_; }
 
     //*************************************
     // Map
@@ -184,11 +209,11 @@ public:
     //*************************************
     size_t numPeds() { return peds_.size(); }
     PedInstance *ped(size_t i) { return peds_[i]; }
-    void addPed(PedInstance *p) { peds_.push_back(p); }
+    void addPed(PedInstance *p);
 
     size_t numVehicles() { return vehicles_.size(); }
     Vehicle *vehicle(size_t i) { return vehicles_[i]; }
-    void addVehicle(Vehicle *pVehicle) { vehicles_.push_back(pVehicle); }
+    void addVehicle(Vehicle *pVehicle);
 
     size_t numWeaponsOnGround() { return weaponsOnGround_.size(); }
     WeaponInstance *weaponOnGround(size_t i) { return weaponsOnGround_[i]; }
@@ -197,7 +222,10 @@ public:
 
     size_t numStatics() { return statics_.size(); }
     Static *statics(size_t i) { return statics_[i]; }
-    void addStatic(Static *pStatic) { statics_.push_back(pStatic); }
+    void addStatic(Static *pStatic) {
+        statics_.push_back(pStatic);
+        objectGrid_.insert(pStatic);
+    }
 
     size_t numSfxObjects() { return sfx_objects_.size(); }
     SFXObject *sfxObjects(size_t i) { return sfx_objects_[i]; }
@@ -247,6 +275,7 @@ public:
      */
     void addArmedPed(PedInstance *pPed) {
         armedPedsVec_.push_back(pPed);
+        thinkStamp_++;
     }
     /*!
      * Returns the number of currently armed peds.
@@ -272,6 +301,18 @@ public:
 
     bool setSurfaces();
     void clrSurfaces();
+    //! Restores in mdpoints_cp_ the nodes modified by the last path search
+    void resetFloodWorkspace();
+    //! Limits the next flood in mdpoints_cp_ to the corridor between two nodes
+    PathRegionGraph::CorridorStatus closeFloodOutsideCorridor(uint32 baseIndex, uint32 targetIndex);
+    //! Returns the regions of the walkable surfaces
+    PathRegionGraph & getRegionGraph() { return regionGraph_; }
+    //! Returns the path finder used by cars
+    RoadPathFinder & getRoadPathFinder() { return roadPathFinder_; }
+    //! Returns the spatial index of peds, vehicles, statics and weapons on ground
+    const MapObjectGrid & getObjectGrid() const { return objectGrid_; }
+    //! Updates the cell of the object in the grid after it has moved
+    void updateObjectCell(MapObject *pObject) { objectGrid_.update(pObject); }
     bool getWalkable(TilePoint &mtp);
     bool getWalkableClosestByZ(TilePoint &mtp);
     bool getShootableTile(TilePoint *pLocT);
@@ -282,13 +323,25 @@ public:
     //*************************************
     //! Check if a tile is blocking the line between originLoc and pTargetPosW
     uint8 checkBlockedByTile(const WorldPoint & originLoc, WorldPoint *pTargetPosW, bool updateLoc, double distanceMax, double *pFinalDest = NULL);
+    //! Check if tiles are blocking each line of the list
+    void checkVisibility(std::vector<VisibilityQuery> &queries);
+    //! Forgets the lines checked during the last tick
+    void clearVisibilityCache() { visibilityCache_.clear(); }
+    //! Returns the lines checked during the current tick
+    const VisibilityCache & getVisibilityCache() const { return visibilityCache_; }
+    //! Finds the objects that can block the lines from originLoc to the targets
+    void findShotBlockerCandidates(const WorldPoint &originLoc,
+        const std::vector<WorldPoint> &targets, const ShootableMapObject *pOrigin,
+        std::vector<MapObject *> &candidates);
     //! Check if an object is blocking the line between originLoc and pTargetPosW
     MapObject * checkBlockedByObject(WorldPoint * originLoc, WorldPoint * pTargetPosW,
-        double *dist, const ShootableMapObject *pOrigin);
+        double *dist, const ShootableMapObject *pOrigin,
+        const std::vector<MapObject *> *pCandidates = NULL);
     //! Check if tile or object blocks the line between originLoc and pTarget
     uint8 checkIfBlockersInShootingLine(const WorldPoint & originLoc, ShootableMapObject **pTarget,
         WorldPoint *pTargetPosW = NULL, bool setBlocker = false,
-        bool checkTileOnly = false, double maxr = -1.0, double * distTo = NULL, const ShootableMapObject *pOrigin = NULL);
+        bool checkTileOnly = false, double maxr = -1.0, double * distTo = NULL, const ShootableMapObject *pOrigin = NULL,
+        const std::vector<MapObject *> *pCandidates = NULL);
     //! Returns the distance between a ped and a object if a path exists between the two
     uint8 getPathLengthBetween(PedInstance *pPed, ShootableMapObject* objectToReach, double distanceMax, double *length);
 
@@ -296,8 +349,14 @@ public:
     uint8 *mtsurfaces_;
     // map-directions points
     floodPointDesc *mdpoints_;
-    // for copy in pathfinding
+    // for copy in pathfinding, equal to mdpoints_ between two path searches
     floodPointDesc *mdpoints_cp_;
+    //! nodes of mdpoints_cp_ reached from the base during a path search
+    std::vector<toSetDesc> flood_base_nodes_;
+    //! nodes of mdpoints_cp_ reached from the target during a path search
+    std::vector<toSetDesc> flood_target_nodes_;
+    //! nodes of mdpoints_cp_ closed to keep the flood inside a corridor
+    std::vector<uint32> flood_fence_nodes_;
     // initialized in set_map, used for in-class calculations
     // map maximum x,y,z values
     int mmax_x_, mmax_y_, mmax_z_;
@@ -311,6 +370,8 @@ public:
     Squad * getSquad() const { return p_squad_; }
 
 protected:
+    //! Follows the line between originLoc and pTargetPosW to find a blocking tile
+    uint8 traceBlockingTiles(const WorldPoint & originLoc, WorldPoint *pTargetPosW, bool updateLoc, double distanceMax, double *pFinalDest = NULL);
     bool sWalkable(char thisTile, char upperTile);
     bool isSurface(char thisTile);
     bool isStairs(char thisTile);
@@ -373,6 +434,29 @@ protected:
      * The squad selected for the mission. It contains only active agents.
      */
     Squad *p_squad_;
+    /*!
+     * Regions of walkable nodes used to speed up path finding.
+     * Built with the surfaces.
+     */
+    PathRegionGraph regionGraph_;
+    /*!
+     * Road directions and search data for cars.
+     */
+    RoadPathFinder roadPathFinder_;
+    /*!
+     * Peds, vehicles, statics and weapons on ground by tile.
+     */
+    MapObjectGrid objectGrid_;
+    //! Objects returned by the grid in checkBlockedByObject()
+    std::vector<MapObject *> blockerCandidates_;
+    //! Results of checkBlockedByTile() during the current tick
+    VisibilityCache visibilityCache_;
+    //! True if a ped or a vehicle has moved during the last step
+    bool objectsMoved_;
+    //! Threads used during the think phase of peds
+    std::unique_ptr<fs_utils::WorkerPool> thinkWorkers_;
+    //! See thinkStamp()
+    uint32 thinkStamp_;
 };
 
 /** \brief Event sent when a mission has ended.
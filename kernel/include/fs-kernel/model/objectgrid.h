@@ -0,0 +1,91 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#ifndef MODEL_OBJECTGRID_H_
+#define MODEL_OBJECTGRID_H_
+
+#include <vector>
+
+#include "fs-utils/common.h"
+#include "fs-kernel/model/position.h"
+
+class MapObject;
+
+/*!
+ * Spatial index of the map objects of a mission.
+ * There is one bucket per tile (x, y) of the map and an object is stored
+ * in the bucket of the tile it stands on (z is ignored). Each object
+ * remembers the bucket it's in, so moving an object costs only when it
+ * changes tile.
+ *
+ * Objects positions are changed in many places, so the index is not
+ * updated when the position is set : the owner must call update() once an
+ * object has moved. Queries widen their area with a margin of kCellMargin
+ * tiles, so that objects that have moved since their last update are
+ * still found. Callers must still check the exact position of the
+ * returned objects.
+ */
+class MapObjectGrid {
+public:
+    //! Value of the cell of an object that is not in the grid
+    static const int kNoCell;
+    //! Number of tiles added around the area of a query
+    static const int kCellMargin;
+
+    MapObjectGrid();
+
+    //! Prepares an empty grid for the given map size
+    void init(int maxX, int maxY);
+    //! Removes all objects
+    void clear();
+
+    //! Adds the object to the grid
+    void insert(MapObject *pObject);
+    //! Removes the object from the grid
+    void remove(MapObject *pObject);
+    //! Moves the object to the bucket of its current tile
+    void update(MapObject *pObject);
+
+    //! Finds objects around a point
+    void findInRange(const WorldPoint &center, int32 range, int natureMask,
+            std::vector<MapObject *> &objects) const;
+    //! Finds objects that may intersect a segment
+    void findAlongSegment(const WorldPoint &from, const WorldPoint &to,
+            int natureMask, std::vector<MapObject *> &objects) const;
+    //! Finds objects inside a rectangle of tiles
+    void findInTileArea(int minTx, int minTy, int maxTx, int maxTy,
+            int natureMask, std::vector<MapObject *> &objects) const;
+
+private:
+    //! Returns the index of the bucket for the given tile
+    int cellOf(int tx, int ty) const;
+
+    int maxX_;
+    int maxY_;
+    //! Largest size on x or y of the objects added to the grid (in tiles)
+    int maxExtent_;
+    //! Objects of each tile
+    std::vector< std::vector<MapObject *> > cells_;
+};
+
+#endif  // MODEL_OBJECTGRID_H_
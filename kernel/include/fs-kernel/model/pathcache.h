@@ -0,0 +1,77 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+#ifndef MODEL_PATHCACHE_H_
+#define MODEL_PATHCACHE_H_
+
+#include "fs-utils/common.h"
+#include "fs-kernel/model/pathsurfaces.h"
+
+/*!
+ * On disk cache of the directions points computed by Mission::setSurfaces().
+ *
+ * There is one file per map in the cache folder. The file is identified
+ * by the map id, the map dimensions and a checksum of the inputs of the
+ * computation : the walk data of the tiles (which includes the large doors)
+ * and the tiles from which the walkable surfaces are flooded.
+ * When one of them changes, the file is ignored and replaced by the new
+ * result. The data is also protected by a checksum so a damaged file
+ * is never used.
+ */
+class PathSurfacesCache {
+public:
+    //! Version of the file format : change it when the computation changes
+    static const uint32 kVersion;
+
+    //! Returns the checksum of the inputs used to compute the points
+    static uint32 inputsChecksum(const uint8 *pSurfaces, size_t nbSurfaces,
+            const uint32 *pSeeds, size_t nbSeeds);
+
+    //! Loads the points of a map from the cache
+    static bool load(uint16 mapId, int maxX, int maxY, int maxZ,
+            uint32 inputsCrc, floodPointDesc *pPoints);
+    //! Saves the points of a map in the cache
+    static bool save(uint16 mapId, int maxX, int maxY, int maxZ,
+            uint32 inputsCrc, const floodPointDesc *pPoints);
+
+private:
+    //! Header of a cache file
+    struct Header {
+        char magic[4];
+        uint32 version;
+        uint32 pointSize;
+        uint32 mapId;
+        uint32 maxX;
+        uint32 maxY;
+        uint32 maxZ;
+        uint32 inputsCrc;
+        uint32 dataCrc;
+    };
+
+    //! Returns the full path of the cache file for the given map
+    static bool cacheFilePath(uint16 mapId, std::string &path);
+    //! Fills a header for the given map
+    static void fillHeader(Header &header, uint16 mapId, int maxX, int maxY,
+            int maxZ, uint32 inputsCrc);
+};
+
+#endif  // MODEL_PATHCACHE_H_
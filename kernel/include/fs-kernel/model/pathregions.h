@@ -0,0 +1,134 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+#ifndef MODEL_PATHREGIONS_H_
+#define MODEL_PATHREGIONS_H_
+
+#include <vector>
+#include <list>
+#include <map>
+
+#include "fs-utils/common.h"
+#include "fs-kernel/model/pathsurfaces.h"
+
+/*!
+ * Cluster level abstraction of the walkable nodes of a mission.
+ * The map is cut in columns of kClusterSize x kClusterSize tiles and
+ * each column is split in regions : a region is a set of walkable nodes
+ * of the same column that are connected to each other.
+ * Regions are linked together when a direction of a node leads to a
+ * node of another region (those nodes are the portals of the region).
+ *
+ * The graph is built once per mission after the surfaces are created.
+ * Path finding asks it for a corridor of regions between the ped and its
+ * destination, so the flood only explores this corridor. Routes between
+ * regions are kept in a LRU cache, so peds going to the same areas share
+ * the cost of the search.
+ */
+class PathRegionGraph {
+public:
+    //! Size of a cluster column in tiles
+    static const int kClusterSize;
+    //! Number of routes kept in the cache
+    static const size_t kRouteCacheSize;
+    //! Value of a node that belongs to no region
+    static const uint32 kNoRegion;
+
+    //! Result of a corridor search
+    enum CorridorStatus {
+        //! No corridor could be computed : the whole map must be flooded
+        kCorridorNone,
+        //! A corridor links the base and the target
+        kCorridorFound,
+        //! There is no walkable path between base and target
+        kCorridorUnreachable
+    };
+
+    PathRegionGraph();
+
+    //! Builds the regions from the directions points of a mission
+    void build(const floodPointDesc *pPoints, int maxX, int maxY, int maxZ);
+    //! Frees all data
+    void clear();
+
+    //! Returns the number of regions
+    size_t numRegions() const { return regions_.size(); }
+    //! Returns the region of the node at the given index
+    uint32 regionOfNode(uint32 nodeIndex) const {
+        return nodeIndex < nodeRegions_.size() ? nodeRegions_[nodeIndex] : kNoRegion;
+    }
+
+    //! Finds the nodes that surround the corridor between two nodes
+    CorridorStatus findCorridor(uint32 baseIndex, uint32 targetIndex,
+            std::vector<uint32> &fenceNodes);
+
+    //! Returns the number of route searches answered by the cache
+    uint32 cacheHits() const { return cacheHits_; }
+    //! Returns the number of route searches that needed a graph search
+    uint32 cacheMisses() const { return cacheMisses_; }
+
+private:
+    /*!
+     * A region of connected nodes inside a cluster.
+     */
+    struct Region {
+        //! Regions that are directly reachable from this one
+        std::vector<uint32> neighbours;
+        //! Nodes outside the region that are reachable from this region
+        std::vector<uint32> portals;
+    };
+
+    //! A route is the list of regions from one region to the other
+    typedef std::vector<uint32> Route;
+    //! Entry of the cache : key of the route and the route
+    typedef std::pair<uint64, Route> RouteEntry;
+
+    //! Fills the list of nodes that can be reached from a node
+    int nodeNeighbours(uint32 nodeIndex, uint32 *pNeighbours) const;
+    //! Returns the route between two regions, from the cache if possible
+    const Route & findRoute(uint32 fromRegion, uint32 toRegion);
+    //! Search the regions graph for a route
+    void searchRoute(uint32 fromRegion, uint32 toRegion, Route &route);
+
+    //! Directions points of the mission
+    const floodPointDesc *pPoints_;
+    int maxX_;
+    int maxY_;
+    int maxXY_;
+    int maxAll_;
+    //! For each node the region it belongs to
+    std::vector<uint32> nodeRegions_;
+    std::vector<Region> regions_;
+    //! Stamp used to mark regions during a search without clearing
+    std::vector<uint32> regionStamps_;
+    //! Parent of each region during a route search
+    std::vector<uint32> regionParents_;
+    uint32 currentStamp_;
+    //! Recently used routes, most recent first
+    std::list<RouteEntry> routesLru_;
+    //! Index of the cached routes by their key
+    std::map<uint64, std::list<RouteEntry>::iterator> routesIndex_;
+    uint32 cacheHits_;
+    uint32 cacheMisses_;
+};
+
+#endif  // MODEL_PATHREGIONS_H_
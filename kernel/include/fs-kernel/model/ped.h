@@ -34,6 +34,7 @@
 #include "fs-utils/common.h"
 #include "fs-engine/gfx/spritemanager.h"
 #include "fs-kernel/model/static.h"
+#include "fs-kernel/model/groupset.h"
 #include "fs-kernel/model/modowner.h"
 #include "fs-kernel/model/weapon.h"
 #include "fs-kernel/model/weaponholder.h"
@@ -260,6 +261,8 @@ public:
     bool switchActionStateTo(uint32 as);
     bool switchActionStateFrom(uint32 as);
     void synchDrawnAnimWithActionState(void);
+    //! Prepares the behaviour before animate() without modifying the mission
+    void think(int elapsed, Mission *pMission) { behaviour_.think(elapsed, pMission); }
     bool animate(int elapsed, Mission *mission);
 
     void drawSelectorAnim(const Point2D &screenPos);
@@ -443,6 +446,7 @@ public:
 
     void setObjGroupID(unsigned int obj_group_id) {
         obj_group_id_ = obj_group_id;
+        group_index_ = GroupSet::indexOf(obj_group_id);
     }
     unsigned int objGroupID() { return obj_group_id_; }
 
@@ -589,7 +593,7 @@ public:
     bool isInEmulatedGroupDef(uint32 eg_id, uint32 eg_def = 0);
     bool isInEmulatedGroupDef(Mmuu32_t &r_egd,
         bool id_only = true);
-    bool emulatedGroupDefsEmpty() { return emulated_group_defs_.size() == 0; }
+    bool emulatedGroupDefsEmpty() { return emulated_group_defs_.empty(); }
 
     typedef std::pair<ShootableMapObject *, double> Pairsmod_t;
     typedef std::map <ShootableMapObject *, double> Msmod_t;
@@ -658,6 +662,13 @@ protected:
     void updatePersuadedRelations(Squad *pSquad);
 
 private:
+    //! Returns true if the group of the ped is in the enemy groups
+    bool hasEnemyGroupOf(PedInstance *pPed);
+    //! Returns true if the group of the ped is in the emulated groups
+    bool emulatesGroupOf(PedInstance *pPed);
+    //! Returns true if an emulated group of the ped is in the enemy groups
+    bool hasEnemyGroupEmulatedBy(PedInstance *pPed);
+
     inline int getClosestDirs(int dir, int& closest, int& closer);
     bool floodMap(Mission *m, const TilePoint &clippedDestPt, floodPointDesc *mdpmirror);
     void removeTilesWithNoChildsFromBase(Mission *m, unsigned short blvl, std::vector <toSetDesc> &bv, std::vector <lvlNodesDesc> &bn, floodPointDesc *mdpmirror);
@@ -703,9 +714,13 @@ protected:
     // ((target checked)desc_state_ & hostile_desc_) != 0 kill him
     uint32 hostile_desc_;
     Mmuu32_t enemy_group_defs_;
+    //! enemy_group_defs_ as bitmasks
+    GroupSet enemy_groups_;
     // if object is not hostile here, enemy_group_defs_ check
     // is skipped, but not hostiles_found_ or desc_state_
     Mmuu32_t emulated_group_defs_;
+    //! emulated_group_defs_ as bitmasks
+    GroupSet emulated_groups_;
     // not set anywhere but used
     Mmuu32_t friend_group_defs_;
     //! dicovered hostiles are set here, only within sight range
@@ -720,6 +735,8 @@ protected:
 
     //! a unique group identification number, 0 - all group IDs
     uint32 obj_group_id_;
+    //! Index of obj_group_id_ in GroupSet
+    int group_index_;
     uint32 old_obj_group_id_;
 
     //! time wait before checking environment (enemies, friends etc)
@@ -0,0 +1,125 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+#ifndef MODEL_ROADPATHFINDER_H_
+#define MODEL_ROADPATHFINDER_H_
+
+#include <vector>
+
+#include "fs-utils/common.h"
+
+/*!
+ * A* search on the road tiles of a map layer, used by cars.
+ *
+ * Road directions (see GenericCar::tileDir()) and walkability of every
+ * tile of the layer are computed once and kept in flat arrays. A node of
+ * the search is a tile plus the direction the car must not take (the
+ * direction it came from), so a node index is (x + y * maxX) * 4 + dir.
+ * The search arrays are kept between two searches and are reset using a
+ * search stamp, so a search costs only for the nodes it visits.
+ */
+class RoadPathFinder {
+public:
+    //! Value of a road direction when tile is not a road
+    static const uint16 kDirNone;
+    //! Value of a road direction when every direction is possible
+    static const uint16 kDirAll;
+
+    //! Result of a search
+    enum SearchStatus {
+        //! Destination was reached
+        kSearchReached,
+        //! Search was too long : path leads to the closest node found
+        kSearchClosest,
+        //! No path exists
+        kSearchFailed
+    };
+
+    RoadPathFinder();
+
+    //! Frees all data
+    void clear();
+
+    //! Returns true if the directions are set for the given layer
+    bool hasLayer(int z) const { return layerZ_ == z && !dirs_.empty(); }
+    //! Prepares the arrays for a new layer
+    void initLayer(int z, int maxX, int maxY);
+    //! Sets the road informations for a tile of the current layer
+    void setTile(int x, int y, uint16 dir, bool walkable);
+    //! Returns the road direction of a tile of the current layer
+    uint16 dirAt(int x, int y) const { return dirs_[static_cast<size_t>(x + y * maxX_)]; }
+
+    //! Returns true if a car can go from a tile with dirStart to a tile with dirEnd
+    static bool areDirsCompatible(uint16 dirStart, uint16 dirEnd);
+
+    //! Finds a path between two tiles of the current layer
+    SearchStatus findPath(int startX, int startY, uint16 startWrongDir,
+            int targetX, int targetY, int maxExpansions,
+            std::vector<int> &pathX, std::vector<int> &pathY);
+
+private:
+    //! An entry in the open list
+    struct OpenNode {
+        //! Estimated cost from start to target through this node
+        uint32 f;
+        //! Cost from start to this node
+        uint32 g;
+        //! Index of the node
+        uint32 node;
+
+        //! Used to build a min heap
+        bool operator<(const OpenNode &other) const {
+            if (f != other.f) {
+                return f > other.f;
+            }
+            // on equal estimation, prefer the nodes closer to target
+            return g < other.g;
+        }
+    };
+
+    //! Returns the index of a wrong direction value
+    static int wrongDirIndex(uint16 wrongDir);
+    //! Returns true if car can drive from a tile to a neighbour tile
+    bool canDrive(size_t fromTile, size_t toTile) const;
+
+    int layerZ_;
+    int maxX_;
+    int maxY_;
+    //! Road direction of each tile
+    std::vector<uint16> dirs_;
+    //! True if a car can drive on the tile
+    std::vector<uint8> walkable_;
+    //! Cost from start of each node
+    std::vector<uint32> costs_;
+    //! Parent of each node
+    std::vector<int32> parents_;
+    //! Stamp of the search that reached the node
+    std::vector<uint32> seenStamps_;
+    //! Stamp of the search that closed the node
+    std::vector<uint32> closedStamps_;
+    //! Binary heap with open nodes
+    std::vector<OpenNode> open_;
+    //! Current search stamp
+    uint32 stamp_;
+};
+
+#endif  // MODEL_ROADPATHFINDER_H_
@@ -0,0 +1,82 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#ifndef MODEL_SIMPROFILE_H_
+#define MODEL_SIMPROFILE_H_
+
+#include <chrono>
+
+#include "fs-utils/common.h"
+
+/*!
+ * Accumulates the time spent in each part of the mission simulation.
+ *
+ * A profile is given to Mission::animate() to measure the update of
+ * every kind of object. Times are summed over all the ticks until the
+ * profile is reset.
+ */
+class SimProfile {
+public:
+    //! Parts of the simulation that are timed
+    enum Subsystem {
+        kSubObjectives = 0,
+        kSubSfx,
+        kSubThink,
+        kSubPeds,
+        kSubVehicles,
+        kSubWeapons,
+        kSubStatics,
+        kSubShots,
+        kSubCount
+    };
+
+    SimProfile();
+
+    //! Sets all times and the number of ticks to zero
+    void reset();
+
+    //! Starts timing a subsystem
+    void begin() { start_ = std::chrono::steady_clock::now(); }
+    //! Adds the time elapsed since begin() to the given subsystem
+    void end(Subsystem sub);
+    //! Counts one more simulated tick
+    void incrTicks() { ticks_++; }
+
+    //! Returns the number of simulated ticks
+    uint32 ticks() const { return ticks_; }
+    //! Returns the total time spent in a subsystem in nanoseconds
+    uint64 total(Subsystem sub) const { return totals_[sub]; }
+    //! Returns the time spent in all subsystems in nanoseconds
+    uint64 total() const;
+    //! Returns a printable name for the subsystem
+    static const char *name(Subsystem sub);
+
+private:
+    //! Time when begin() was last called
+    std::chrono::steady_clock::time_point start_;
+    //! Time spent in each subsystem in nanoseconds
+    uint64 totals_[kSubCount];
+    uint32 ticks_;
+};
+
+#endif  // MODEL_SIMPROFILE_H_
@@ -145,6 +145,9 @@ private:
 class GenericCar : public Vehicle
 {
 public:
+    //! Max number of nodes explored when searching a path on roads
+    static const int kMaxRoadSearchExpansions;
+
     GenericCar(VehicleAnimation *pAnimation, uint16 id, uint8 aType, Map *pMap);
     virtual ~GenericCar() {}
 
@@ -0,0 +1,106 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#ifndef MODEL_VISIBILITY_H_
+#define MODEL_VISIBILITY_H_
+
+#include <map>
+
+#include "fs-utils/common.h"
+#include "fs-kernel/model/position.h"
+
+/*!
+ * A line of sight request between two points, used to check many lines
+ * at once (see Mission::checkVisibility()).
+ */
+struct VisibilityQuery {
+    //! Start of the line
+    WorldPoint originPosW;
+    //! End of the line
+    WorldPoint targetPosW;
+    //! Maximum length of the line
+    double distanceMax;
+    //! Result of Mission::checkBlockedByTile() for the line
+    uint8 result;
+};
+
+/*!
+ * Results of the tile blocking checks done during the current game tick.
+ * Many peds look at the same targets during a tick, so a line that has
+ * already been traced is not traced again.
+ * A result is stored for the exact positions of both ends of the line :
+ * as soon as one of them moves, the line is traced again. The map tiles
+ * don't change during a mission, so the only reason to clear the cache
+ * is to limit its size : it's done at the start of each tick.
+ */
+class VisibilityCache {
+public:
+    /*!
+     * What Mission::checkBlockedByTile() returns for a line.
+     */
+    struct Result {
+        //! The returned bitmask
+        uint8 mask;
+        //! The end of the line after the check
+        WorldPoint reachedPosW;
+        //! Distance between the two ends of the line
+        double distance;
+    };
+
+    VisibilityCache();
+
+    //! Removes all stored results
+    void clear();
+
+    //! Looks for the result of a line
+    bool find(const WorldPoint &originPosW, const WorldPoint &targetPosW,
+            double distanceMax, Result *pResult);
+    //! Stores the result of a line
+    void store(const WorldPoint &originPosW, const WorldPoint &targetPosW,
+            double distanceMax, const Result &result);
+
+    //! Returns the number of lines found in the cache
+    uint32 hits() const { return hits_; }
+    //! Returns the number of lines that were not in the cache
+    uint32 misses() const { return misses_; }
+
+private:
+    /*!
+     * Identifies a line.
+     */
+    struct LineKey {
+        int coords[6];
+        double distanceMax;
+
+        LineKey(const WorldPoint &originPosW, const WorldPoint &targetPosW,
+                double distMax);
+
+        bool operator<(const LineKey &other) const;
+    };
+
+    std::map<LineKey, Result> results_;
+    uint32 hits_;
+    uint32 misses_;
+};
+
+#endif  // MODEL_VISIBILITY_H_
@@ -0,0 +1,132 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include "fs-kernel/ia/actionpool.h"
+
+#include <new>
+
+//! Blocks sizes are multiples of this granularity
+static const size_t kBlockGranularity = 16;
+//! Number of blocks carved from a chunk at once
+static const size_t kBlocksPerChunk = 64;
+
+const size_t ActionPool::kMaxBlockSize = 256;
+
+ActionPool::ActionPool() : freeLists_(kMaxBlockSize / kBlockGranularity, NULL) {
+    stats_.allocations = 0;
+    stats_.reuses = 0;
+    stats_.heapAllocations = 0;
+    stats_.inUse = 0;
+    stats_.bytesReserved = 0;
+}
+
+ActionPool::~ActionPool() {
+    for (size_t i = 0; i < chunks_.size(); i++) {
+        ::operator delete(chunks_[i]);
+    }
+}
+
+/*!
+ * Takes a block from the free list of the size class. When the list
+ * is empty, a new chunk is split in blocks of that class.
+ * \param size Size of the object
+ * \return A block aligned like the general allocator
+ */
+void *ActionPool::allocate(size_t size) {
+    stats_.allocations++;
+    stats_.inUse++;
+    if (size == 0 || size > kMaxBlockSize) {
+        stats_.heapAllocations++;
+        return ::operator new(size);
+    }
+
+    size_t sizeClass = (size - 1) / kBlockGranularity;
+    FreeBlock *pBlock = freeLists_[sizeClass];
+    if (pBlock != NULL) {
+        stats_.reuses++;
+    } else {
+        size_t blockSize = (sizeClass + 1) * kBlockGranularity;
+        char *pChunk = static_cast<char *>(::operator new(blockSize * kBlocksPerChunk));
+        chunks_.push_back(pChunk);
+        stats_.heapAllocations++;
+        stats_.bytesReserved += blockSize * kBlocksPerChunk;
+        // blocks are linked in address order, the first one is returned
+        for (size_t i = kBlocksPerChunk; i > 0; i--) {
+            FreeBlock *pFree = reinterpret_cast<FreeBlock *>(pChunk + (i - 1) * blockSize);
+            pFree->pNext = pBlock;
+            pBlock = pFree;
+        }
+    }
+
+    freeLists_[sizeClass] = pBlock->pNext;
+    return pBlock;
+}
+
+/*!
+ * Puts the block back in the free list of its size class.
+ * \param p Block to release (can be NULL)
+ * \param size Size given to allocate()
+ */
+void ActionPool::release(void *p, size_t size) {
+    if (p == NULL) {
+        return;
+    }
+
+    stats_.inUse--;
+    if (size == 0 || size > kMaxBlockSize) {
+        ::operator delete(p);
+        return;
+    }
+
+    size_t sizeClass = (size - 1) / kBlockGranularity;
+    FreeBlock *pBlock = static_cast<FreeBlock *>(p);
+    pBlock->pNext = freeLists_[sizeClass];
+    freeLists_[sizeClass] = pBlock;
+}
+
+void ActionPool::resetStats() {
+    stats_.allocations = 0;
+    stats_.reuses = 0;
+    stats_.heapAllocations = 0;
+}
+
+/*!
+ * Gives all chunks back to the general allocator. This is done only
+ * when no action is alive, as a chunk cannot be freed block by block.
+ * \return true if chunks were freed
+ */
+bool ActionPool::trim() {
+    if (stats_.inUse != 0) {
+        return false;
+    }
+
+    for (size_t i = 0; i < chunks_.size(); i++) {
+        ::operator delete(chunks_[i]);
+    }
+    chunks_.clear();
+    for (size_t i = 0; i < freeLists_.size(); i++) {
+        freeLists_[i] = NULL;
+    }
+    stats_.bytesReserved = 0;
+    return true;
+}
@@ -48,6 +48,8 @@ const uint8 ShootAction::kShootActionNotAdded = 0;
 const uint8 ShootAction::kShootActionAutomaticShoot = 1;
 const uint8 ShootAction::kShootActionSingleShoot = 2;
 
+ActionPool Action::pool_;
+
 /*!
  * Default constructor.
  * \param aType What type of action.
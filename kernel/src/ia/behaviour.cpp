@@ -42,6 +42,8 @@ const double PersuadedBehaviourComponent::kMaxRangeForSearchingWeapon = 500.0;
 const int PoliceBehaviourComponent::kPoliceScoutDistance = 1500;
 const int PoliceBehaviourComponent::kPolicePendingTime = 1500;
 const int PlayerHostileBehaviourComponent::kEnemyScoutDistance = 1500;
+//! A step of 33ms leaves this margin to objects moving up to 7000 per second
+const int ScoutCandidates::kMoveMargin = 256;
 
 Behaviour::~Behaviour() {
     destroyComponents();
@@ -74,6 +76,26 @@ void Behaviour::replaceAllcomponentsBy(BehaviourComponent *pComp) {
     addComponent(pComp);
 }
 
+/*!
+ * Run the think method of each enabled component.
+ * This method can be called at the same time for different peds.
+ * \param elapsed Time elapsed since last frame
+ * \param pMission Mission data
+ */
+void Behaviour::think(int elapsed, Mission *pMission) {
+    if (pThisPed_->isDead()) {
+        return;
+    }
+
+    for (std::list < BehaviourComponent * >::iterator it = compLst_.begin();
+            it != compLst_.end(); it++) {
+        BehaviourComponent *pComp = *it;
+        if (pComp->isEnabled()) {
+            pComp->think(elapsed, pMission, pThisPed_);
+        }
+    }
+}
+
 /*!
  * Run the execute method  of each component listed in the behaviour.
  * Component must be enabled.
@@ -132,22 +154,53 @@ PersuaderBehaviourComponent::PersuaderBehaviourComponent():
     persuadotronRange_ = g_weaponMgr.getWeapon(Weapon::Persuadatron)->range();
 }
 
-void PersuaderBehaviourComponent::execute(int elapsed, Mission *pMission, PedInstance *pPed) {
-    // Check if Agent has selected his Persuadotron
+/*!
+ * Keeps the peds that are close enough to be persuaded.
+ */
+void PersuaderBehaviourComponent::think(int /*elapsed*/, Mission *pMission, PedInstance *pPed) {
+    candidates_.clear();
     if (doUsePersuadotron_) {
         // iterate through all peds except our agents
         for (size_t i = pMission->getSquad()->size(); i < pMission->numPeds(); i++) {
             PedInstance *pOtherPed = pMission->ped(i);
-            if (pPed->canPersuade(pOtherPed, persuadotronRange_)) {
-                fs_dmg::DamageToInflict dmg;
-                dmg.dtype = fs_dmg::kDmgTypePersuasion;
-                dmg.d_owner = pPed;
-                pOtherPed->insertHitAction(dmg);
+            if (!pOtherPed->isPersuaded() && pOtherPed->isAlive() &&
+                pPed->isCloseTo(pOtherPed, persuadotronRange_ + ScoutCandidates::kMoveMargin)) {
+                candidates_.add(pOtherPed);
             }
         }
+        candidates_.validate(pMission->thinkStamp());
     }
 }
 
+void PersuaderBehaviourComponent::execute(int /*elapsed*/, Mission *pMission, PedInstance *pPed) {
+    // Check if Agent has selected his Persuadotron
+    if (doUsePersuadotron_) {
+        if (candidates_.isValid(pMission->thinkStamp())) {
+            for (size_t i = 0; i < candidates_.size(); i++) {
+                PedInstance *pOtherPed = candidates_.ped(i);
+                if (pPed->canPersuade(pOtherPed, persuadotronRange_)) {
+                    persuade(pPed, pOtherPed);
+                }
+            }
+        } else {
+            // iterate through all peds except our agents
+            for (size_t i = pMission->getSquad()->size(); i < pMission->numPeds(); i++) {
+                PedInstance *pOtherPed = pMission->ped(i);
+                if (pPed->canPersuade(pOtherPed, persuadotronRange_)) {
+                    persuade(pPed, pOtherPed);
+                }
+            }
+        }
+    }
+}
+
+void PersuaderBehaviourComponent::persuade(PedInstance *pPed, PedInstance *pOtherPed) {
+    fs_dmg::DamageToInflict dmg;
+    dmg.dtype = fs_dmg::kDmgTypePersuasion;
+    dmg.d_owner = pPed;
+    pOtherPed->insertHitAction(dmg);
+}
+
 void PersuaderBehaviourComponent::handleBehaviourEvent(PedInstance *pPed, Behaviour::BehaviourEvent evtType, void *pCtxt) {
     switch(evtType) {
     case Behaviour::kBehvEvtPersuadotronActivated:
@@ -297,6 +350,25 @@ PanicComponent::PanicComponent():
     setEnabled(false);
 }
 
+/*!
+ * Keeps the armed peds that may be close when the civilian looks around.
+ */
+void PanicComponent::think(int elapsed, Mission *pMission, PedInstance *pCivil) {
+    candidates_.clear();
+    if (pCivil->isPanicImmuned() || status_ != kPanicStatusAlert
+        || !scoutTimer_.willReach(static_cast<uint32>(elapsed))) {
+        return;
+    }
+
+    for (size_t i = 0; i < pMission->numArmedPeds(); i++) {
+        PedInstance *pOtherPed = pMission->armedPedAtIndex(i);
+        if (pCivil->isCloseTo(pOtherPed, kScoutDistance + ScoutCandidates::kMoveMargin)) {
+            candidates_.add(pOtherPed);
+        }
+    }
+    candidates_.validate(pMission->thinkStamp());
+}
+
 void PanicComponent::execute(int elapsed, Mission *pMission, PedInstance *pCivil) {
     if (pCivil->isPanicImmuned()) {
         return;
@@ -364,6 +436,16 @@ void PanicComponent::handleBehaviourEvent(PedInstance *pCivil, Behaviour::Behavi
  * \return NULL if no ped is found
  */
 PedInstance * PanicComponent::findNearbyArmedPed(Mission *pMission, PedInstance *pPed) {
+    if (candidates_.isValid(pMission->thinkStamp())) {
+        // the list of armed peds has not changed since the think phase
+        for (size_t i = 0; i < candidates_.size(); i++) {
+            if (pPed->isCloseTo(candidates_.ped(i), kScoutDistance)) {
+                return candidates_.ped(i);
+            }
+        }
+        return NULL;
+    }
+
     for (size_t i = 0; i < pMission->numArmedPeds(); i++) {
         PedInstance *pOtherPed = pMission->armedPedAtIndex(i);
         if (pPed->isCloseTo(pOtherPed, kScoutDistance)) {
@@ -404,6 +486,26 @@ PoliceBehaviourComponent::PoliceBehaviourComponent():
     pTarget_ = NULL;
 }
 
+/*!
+ * Keeps the armed peds that may be close when the police officer looks around.
+ */
+void PoliceBehaviourComponent::think(int elapsed, Mission *pMission, PedInstance *pPed) {
+    candidates_.clear();
+    if (!(status_ == kPoliceStatusAlert && scoutTimer_.willReach(static_cast<uint32>(elapsed)))
+        && status_ != kPoliceStatusCheckReengageOrDefault) {
+        return;
+    }
+
+    for (size_t i = 0; i < pMission->numArmedPeds(); i++) {
+        PedInstance *pOtherPed = pMission->armedPedAtIndex(i);
+        if (pPed != pOtherPed && pOtherPed->type() != PedInstance::kPedTypePolice &&
+            pPed->isCloseTo(pOtherPed, kPoliceScoutDistance + ScoutCandidates::kMoveMargin)) {
+            candidates_.add(pOtherPed);
+        }
+    }
+    candidates_.validate(pMission->thinkStamp());
+}
+
 void PoliceBehaviourComponent::execute(int elapsed, Mission *pMission, PedInstance *pPed) {
     if (status_ == kPoliceStatusAlert && scoutTimer_.update(elapsed)) {
         findAndEngageNewTarget(pMission, pPed);
@@ -494,6 +596,16 @@ bool PoliceBehaviourComponent::findAndEngageNewTarget(Mission *pMission, PedInst
  * Return a ped that has his weapon out and is not a police man and is close to this policeman.
  */
 PedInstance * PoliceBehaviourComponent::findArmedPedNotPolice(Mission *pMission, PedInstance *pPed) {
+    if (candidates_.isValid(pMission->thinkStamp())) {
+        // the list of armed peds has not changed since the think phase
+        for (size_t i = 0; i < candidates_.size(); i++) {
+            if (pPed->isCloseTo(candidates_.ped(i), kPoliceScoutDistance)) {
+                return candidates_.ped(i);
+            }
+        }
+        return NULL;
+    }
+
     for (size_t i = 0; i < pMission->numArmedPeds(); i++) {
         PedInstance *pOtherPed = pMission->armedPedAtIndex(i);
         if (pPed != pOtherPed && pOtherPed->type() != PedInstance::kPedTypePolice && pPed->isCloseTo(pOtherPed, kPoliceScoutDistance)) {
@@ -551,6 +663,25 @@ PlayerHostileBehaviourComponent::PlayerHostileBehaviourComponent():
     status_ = kHostileStatusDefault;
 }
 
+/*!
+ * Keeps the player agents that may be close when the ped looks for them.
+ */
+void PlayerHostileBehaviourComponent::think(int /*elapsed*/, Mission *pMission, PedInstance *pPed) {
+    candidates_.clear();
+    if (status_ != kHostileStatusDefault && status_ != kHostileStatusCheckForDefault) {
+        return;
+    }
+
+    for (size_t i = 0; i < pMission->getSquad()->size(); i++) {
+        PedInstance *pAgent = pMission->getSquad()->member(i);
+        if (pAgent && pAgent->isAlive() &&
+            pPed->isCloseTo(pAgent, kEnemyScoutDistance + ScoutCandidates::kMoveMargin)) {
+            candidates_.add(pAgent);
+        }
+    }
+    candidates_.validate(pMission->thinkStamp());
+}
+
 void PlayerHostileBehaviourComponent::execute(int elapsed, Mission *pMission, PedInstance *pPed) {
     if (status_ == kHostileStatusDefault) {
         // In this mode, ped is looking for an enemy
@@ -591,6 +722,16 @@ void PlayerHostileBehaviourComponent::handleBehaviourEvent(PedInstance *pPed, Be
 }
 
 PedInstance * PlayerHostileBehaviourComponent::findPlayerAgent(Mission *pMission, PedInstance *pPed) {
+    if (candidates_.isValid(pMission->thinkStamp())) {
+        for (size_t i = 0; i < candidates_.size(); i++) {
+            PedInstance *pAgent = candidates_.ped(i);
+            if (pAgent->isAlive() && pPed->isCloseTo(pAgent, kEnemyScoutDistance)) {
+                return pAgent;
+            }
+        }
+        return NULL;
+    }
+
     for (size_t i = 0; i < pMission->getSquad()->size(); i++) {
         PedInstance *pAgent = pMission->getSquad()->member(i);
         if (pAgent && pAgent->isAlive() && pPed->isCloseTo(pAgent, kEnemyScoutDistance)) {
@@ -120,6 +120,11 @@ MissionBriefing *MissionManager::loadBriefing(int n) {
             return NULL;
         }
         p_mb->init_minimap(p_map, level_data);
+
+        // Mission data will be read again when player starts the mission
+        char gameFile[100];
+        sprintf(gameFile, GAME_PATTERN, n);
+        File::prefetchOriginalFile(gameFile);
     }
 
     return p_mb;
@@ -0,0 +1,110 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include "fs-kernel/model/groupset.h"
+
+const int GroupSet::kMaxGroups = 64;
+const int GroupSet::kNoGroup = -1;
+
+/*!
+ * Indexes are created the first time a group id is seen and are kept
+ * for the whole game : missions use only a few group ids.
+ * \param groupId The group id
+ * \return The index or kNoGroup if all indexes are used
+ */
+int GroupSet::indexOf(uint32 groupId) {
+    static std::map<uint32, int> s_indexes;
+
+    std::map<uint32, int>::iterator it = s_indexes.find(groupId);
+    if (it != s_indexes.end()) {
+        return it->second;
+    }
+
+    if (s_indexes.size() >= static_cast<size_t>(kMaxGroups)) {
+        return kNoGroup;
+    }
+
+    int index = static_cast<int>(s_indexes.size());
+    s_indexes[groupId] = index;
+    return index;
+}
+
+GroupSet::GroupSet() {
+    groups_ = 0;
+    allDefs_ = 0;
+    exact_ = true;
+}
+
+/*!
+ * \param defs For each group id, the defs : a def of 0 means all defs
+ */
+void GroupSet::set(const std::multimap<uint32, uint32> &defs) {
+    groups_ = 0;
+    allDefs_ = 0;
+    defs_.clear();
+    exact_ = true;
+
+    for (std::multimap<uint32, uint32>::const_iterator it = defs.begin();
+        it != defs.end(); ++it) {
+        int index = indexOf(it->first);
+        if (index == kNoGroup) {
+            exact_ = false;
+            continue;
+        }
+
+        uint64 bit = 1ULL << index;
+        groups_ |= bit;
+        if (it->second == 0) {
+            allDefs_ |= bit;
+        } else {
+            defs_.push_back(std::make_pair(index, it->second));
+        }
+    }
+}
+
+/*!
+ * Same result as PedInstance::Mmuu32_t::isIn().
+ * \param groupIndex Index of the group id (can be kNoGroup)
+ * \param groupDef The def or 0 for any def
+ */
+bool GroupSet::contains(int groupIndex, uint32 groupDef) const {
+    if (groupIndex == kNoGroup) {
+        // a group without index can't be in an exact set
+        return false;
+    }
+
+    uint64 bit = 1ULL << groupIndex;
+    if ((groups_ & bit) == 0) {
+        return false;
+    }
+    if (groupDef == 0 || (allDefs_ & bit) != 0) {
+        return true;
+    }
+
+    for (size_t i = 0; i < defs_.size(); i++) {
+        if (defs_[i].first == groupIndex && defs_[i].second == groupDef) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -29,6 +29,7 @@
 
 #include "fs-engine/gfx/tile.h"
 #include "fs-kernel/model/map.h"
+#include "fs-kernel/model/objectgrid.h"
 
 MapObject::MapObject(uint16 anId, Map *pMap, ObjectNature aNature):
     size_x_(1), size_y_(1), size_z_(2),
@@ -41,6 +42,7 @@ MapObject::MapObject(uint16 anId, Map *pMap, ObjectNature aNature):
 {
     nature_ = aNature;
     id_ = anId;
+    gridCell_ = MapObjectGrid::kNoCell;
     pMap_ = pMap;
     isDrawable_ = true;
 }
@@ -31,19 +31,81 @@
 #include <string.h>
 #include <assert.h>
 #include <string>
+#include <algorithm>
 
 #include "fs-utils/log/log.h"
+#include "fs-utils/misc/workerpool.h"
 #include "fs-engine/sound/soundmanager.h"
 #include "fs-engine/gfx/screen.h"
 #include "fs-engine/events/event.h"
 #include "fs-kernel/model/shot.h"
 #include "fs-kernel/model/objectivedesc.h"
+#include "fs-kernel/model/pathcache.h"
 #include "fs-kernel/model/vehicle.h"
 #include "fs-kernel/model/squad.h"
+#include "fs-kernel/ia/actions.h"
 
 const uint8 Mission::kBMaskBlockerTargetOutOfMap = 0x20;
 const uint8 Mission::kBMaskBlockerTargetObjectUpdated = 0x02;
 const uint8 Mission::kBMaskBlockerTargetPosUpdated = 0x04;
+const double Mission::kTileCheckStep = 8.0;
+const size_t Mission::kMinPedsForWorkers = 64;
+
+namespace {
+    /*!
+     * Returns the height of the slope of stairs above the bottom of the tile.
+     * \param twd Type of stairs (0x01 to 0x04)
+     * \param offX Offset on X in the tile
+     * \param offY Offset on Y in the tile
+     */
+    double stairsHeight(uint8 twd, double offX, double offY) {
+        switch (twd) {
+        case 0x01:
+            return 127 - offY / 2;
+        case 0x02:
+            return offY / 2;
+        case 0x03:
+            return offX / 2;
+        default:
+            return 127 - offX / 2;
+        }
+    }
+
+    /*!
+     * Finds where a path crosses the slope of stairs inside a tile.
+     * The height above the slope changes linearly along the path, so it
+     * is only computed at both ends of the path in the tile.
+     * \param twd Type of stairs (0x01 to 0x04)
+     * \param origin Start of the path
+     * \param dir Direction of the path (unit vector)
+     * \param tile The tile with the stairs
+     * \param tStart Distance at which the path enters the tile
+     * \param tStop Distance at which the path leaves the tile
+     * \param pHit Set with the distance of the hit
+     * \return true if the path goes below the slope
+     */
+    bool hitOnStairs(uint8 twd, const double *origin, const double *dir,
+                     const int *tile, double tStart, double tStop, double *pHit) {
+        double aboveSlope[2];
+        double t[2] = {tStart, std::max(tStart, tStop)};
+        for (int i = 0; i < 2; i++) {
+            double offX = origin[0] + dir[0] * t[i] - tile[0] * 256;
+            double offY = origin[1] + dir[1] * t[i] - tile[1] * 256;
+            double offZ = origin[2] + dir[2] * t[i] - tile[2] * 128;
+            aboveSlope[i] = offZ - stairsHeight(twd, offX, offY);
+        }
+
+        if (aboveSlope[0] <= 0) {
+            *pHit = t[0];
+            return true;
+        }
+        if (aboveSlope[1] <= 0) {
+            *pHit = t[0] + (t[1] - t[0]) * aboveSlope[0] / (aboveSlope[0] - aboveSlope[1]);
+            return true;
+        }
+        return false;
+    }
+}
 
 /*!
  * Initialize the statistics.
@@ -76,6 +138,8 @@ Mission::Mission(const LevelData::MapInfos & map_infos, Map *pMap)
     max_x_ = READ_LE_UINT16(map_infos.max_x) / 2;
     max_y_ = READ_LE_UINT16(map_infos.max_y) / 2;
     cur_objective_ = 0;
+    objectsMoved_ = false;
+    thinkStamp_ = 0;
     p_minimap_ = NULL;
     set_map(pMap);
     p_squad_ = new Squad();
@@ -99,6 +163,7 @@ Mission::~Mission()
     for (unsigned int i = 0; i < objectives_.size(); i++)
         delete objectives_[i];
     armedPedsVec_.clear();
+    objectGrid_.clear();
     clrSurfaces();
 
     if (p_minimap_) {
@@ -108,6 +173,12 @@ Mission::~Mission()
     if (p_squad_) {
         delete p_squad_;
     }
+
+    // actions of the mission have been deleted with the peds
+    if (!Action::pool().trim()) {
+        LOG(Log::k_FLG_GAME, "Mission", "~Mission()", ("%llu actions still allocated",
+            Action::pool().stats().inUse));
+    }
 }
 
 void Mission::delPrjShot(size_t i) {
@@ -123,6 +194,7 @@ void Mission::removeArmedPed(PedInstance *pPed) {
     for (size_t i = 0; i < armedPedsVec_.size();  i++) {
         if (pPed == armedPedsVec_[i]) {
             armedPedsVec_.erase(armedPedsVec_.begin() + i);
+            thinkStamp_++;
             break;
         }
     }
@@ -148,6 +220,7 @@ void Mission::set_map(Map *p_map) {
     if (p_map) {
         p_map_ = p_map;
         p_map_->mapDimensions(&mmax_x_, &mmax_y_, &mmax_z_);
+        objectGrid_.init(mmax_x_, mmax_y_);
 
         if (p_minimap_) {
             delete p_minimap_;
@@ -171,9 +244,28 @@ void Mission::start(WeaponManager& weaponMgr)
     LOG(Log::k_FLG_GAME, "Mission", "start()", ("Start mission"));
     // Reset mission statistics
     stats_.init(p_squad_->size());
+    Action::pool().resetStats();
 
     cur_objective_ = 0;
 
+    // objects positions and sizes may have been set after they were
+    // added to the mission, so put them again in the grid
+    std::vector<MapObject *> gridObjects(peds_.begin(), peds_.end());
+    gridObjects.insert(gridObjects.end(), vehicles_.begin(), vehicles_.end());
+    gridObjects.insert(gridObjects.end(), statics_.begin(), statics_.end());
+    gridObjects.insert(gridObjects.end(), weaponsOnGround_.begin(), weaponsOnGround_.end());
+    objectGrid_.init(mmax_x_, mmax_y_);
+    for (size_t i = 0; i < gridObjects.size(); i++) {
+        gridObjects[i]->setGridCell(MapObjectGrid::kNoCell);
+        objectGrid_.insert(gridObjects[i]);
+    }
+
+    // each thread thinks for kMinPedsForWorkers peds at least, so small
+    // maps don't start threads that would have nothing to do
+    size_t nbThinkThreads = peds_.size() / kMinPedsForWorkers;
+    setThinkWorkers(nbThinkThreads > 1 ?
+        std::min(fs_utils::WorkerPool::defaultSize(), nbThinkThreads - 1) : 0);
+
     // creating a list of available weapons
     // TODO: consider weight of weapons when adding?
     std::vector <Weapon *> wpns;
@@ -322,6 +414,16 @@ void Mission::updateStats()
     }
 }
 
+void Mission::addPed(PedInstance *p) {
+    peds_.push_back(p);
+    objectGrid_.insert(p);
+}
+
+void Mission::addVehicle(Vehicle *pVehicle) {
+    vehicles_.push_back(pVehicle);
+    objectGrid_.insert(pVehicle);
+}
+
 void Mission::addWeaponToGround(WeaponInstance * w)
 {
     for (unsigned int i = 0; i < weaponsOnGround_.size(); i++) {
@@ -330,6 +432,7 @@ void Mission::addWeaponToGround(WeaponInstance * w)
             return;
     }
     weaponsOnGround_.push_back(w);
+    objectGrid_.insert(w);
 }
 
 void Mission::removeWeaponOnGround(WeaponInstance *pWeapon) {
@@ -338,6 +441,112 @@ void Mission::removeWeaponOnGround(WeaponInstance *pWeapon) {
             weaponsOnGround_.erase(weaponsOnGround_.begin() + i);
         }
     }
+    objectGrid_.remove(pWeapon);
+}
+
+/*!
+ * \param nbWorkers Number of threads in addition to the calling thread.
+ * With 0, the think phase runs only in the calling thread.
+ */
+void Mission::setThinkWorkers(size_t nbWorkers) {
+    if (nbWorkers == 0) {
+        thinkWorkers_.reset();
+    } else if (!thinkWorkers_ || thinkWorkers_->size() != nbWorkers) {
+        thinkWorkers_ = std::make_unique<fs_utils::WorkerPool>(nbWorkers);
+    }
+}
+
+/*!
+ * Animates all the objects of the mission for one simulation step :
+ * special effects, peds, vehicles, weapons on the ground, statics and
+ * projectiles. Peds and vehicles save their position before moving so
+ * they can be drawn between their two positions.
+ * Before the peds are animated, their behaviours prepare their searches
+ * in a think phase that may run on several threads.
+ * \param elapsed Time elapsed since the last step
+ * \param pProfile If not null, receives the time spent on each kind of object
+ * \return True if an object has changed and must be drawn again
+ */
+bool Mission::animate(int elapsed, SimProfile *pProfile) {
+    bool change = false;
+    // lines of sight checked during last step are outdated
+    visibilityCache_.clear();
+
+    if (pProfile) pProfile->begin();
+    for (size_t i = 0; i < sfx_objects_.size(); i++) {
+        SFXObject *pSfx = sfx_objects_[i];
+        change |= pSfx->animate(elapsed);
+        if (pSfx->sfxLifeOver()) {
+            delSfxObject(i);
+            i--;
+        }
+    }
+    if (pProfile) pProfile->end(SimProfile::kSubSfx);
+
+    // think phase : behaviours look around using the state of the mission
+    // at the start of the step, so peds can be shared between threads
+    thinkStamp_++;
+    if (pProfile) pProfile->begin();
+    if (thinkWorkers_ && peds_.size() >= kMinPedsForWorkers) {
+        thinkWorkers_->run(peds_.size(), [this, elapsed](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) {
+                peds_[i]->think(elapsed, this);
+            }
+        });
+    } else {
+        for (size_t i = 0; i < peds_.size(); i++) {
+            peds_[i]->think(elapsed, this);
+        }
+    }
+    if (pProfile) pProfile->end(SimProfile::kSubThink);
+
+    // update phase : peds act one after the other
+    // after moving, objects are put in the grid cell of their new tile
+    objectsMoved_ = false;
+    if (pProfile) pProfile->begin();
+    for (size_t i = 0; i < peds_.size(); i++) {
+        PedInstance *pPed = peds_[i];
+        pPed->savePreviousPosition();
+        change |= pPed->animate(elapsed, this);
+        objectGrid_.update(pPed);
+        objectsMoved_ |= pPed->hasMovedSinceLastTick();
+    }
+    if (pProfile) pProfile->end(SimProfile::kSubPeds);
+
+    if (pProfile) pProfile->begin();
+    for (size_t i = 0; i < vehicles_.size(); i++) {
+        Vehicle *pVehicle = vehicles_[i];
+        pVehicle->savePreviousPosition();
+        change |= pVehicle->animate(elapsed);
+        objectGrid_.update(pVehicle);
+        objectsMoved_ |= pVehicle->hasMovedSinceLastTick();
+    }
+    if (pProfile) pProfile->end(SimProfile::kSubVehicles);
+
+    if (pProfile) pProfile->begin();
+    for (size_t i = 0; i < weaponsOnGround_.size(); i++) {
+        change |= weaponsOnGround_[i]->animate(elapsed);
+        objectGrid_.update(weaponsOnGround_[i]);
+    }
+    if (pProfile) pProfile->end(SimProfile::kSubWeapons);
+
+    if (pProfile) pProfile->begin();
+    for (size_t i = 0; i < statics_.size(); i++) {
+        change |= statics_[i]->animate(elapsed);
+    }
+    if (pProfile) pProfile->end(SimProfile::kSubStatics);
+
+    if (pProfile) pProfile->begin();
+    for (size_t i = 0; i < prj_shots_.size(); i++) {
+        change |= prj_shots_[i]->animate(elapsed, this);
+        if (prj_shots_[i]->isLifeOver()) {
+            delPrjShot(i);
+            i--;
+        }
+    }
+    if (pProfile) pProfile->end(SimProfile::kSubShots);
+
+    return change;
 }
 
 MapObject * Mission::findObjectWithNatureAtPos(int tilex, int tiley, int tilez,
@@ -425,7 +634,6 @@ bool Mission::setSurfaces() {
     }
     mmax_m_xy = mmax_x_ * mmax_y_;
     memset((void *)mtsurfaces_, 0, mmax_m_all * sizeof(uint8));
-    memset((void *)mdpoints_, 0, mmax_m_all * sizeof(floodPointDesc));
     for (int ix = 0; ix < mmax_x_; ++ix) {
         for (int iy = 0; iy < mmax_y_; ++iy) {
             for (int iz = 0; iz < mmax_z_; ++iz) {
@@ -461,16 +669,33 @@ bool Mission::setSurfaces() {
     //printf("surface data size %i\n", sizeof(surfaceDesc) * mmax_m_all);
     //printf("flood data size %i\n", sizeof(floodPointDesc) * mmax_m_all);
 
+    // surfaces are flooded from the peds positions : with the walk data,
+    // they identify the result in the cache
+    std::vector<uint32> seeds;
+    std::vector<PedInstance *> misplacedPeds;
     for (unsigned int i = 0; i < peds_.size(); ++i) {
         PedInstance *p = peds_[i];
-        int x = p->tileX();
-        int y = p->tileY();
-        int z = p->tileZ();
-        if (z >= mmax_z_ || z < 0 || p->isDead()) {
-            // TODO : check on all maps those peds correct position
-            p->setTileZ(mmax_z_ - 1);
+        if (p->tileZ() >= mmax_z_ || p->tileZ() < 0 || p->isDead()) {
+            misplacedPeds.push_back(p);
             continue;
         }
+        seeds.push_back(static_cast<uint32>(p->tileX() + p->tileY() * mmax_x_
+            + p->tileZ() * mmax_m_xy));
+    }
+    uint32 inputsCrc = PathSurfacesCache::inputsChecksum(mtsurfaces_,
+        static_cast<size_t>(mmax_m_all), seeds.data(), seeds.size());
+    bool fromCache = PathSurfacesCache::load(p_map_->id(), mmax_x_, mmax_y_,
+        mmax_z_, inputsCrc, mdpoints_);
+    if (fromCache) {
+        LOG(Log::k_FLG_GAME, "Mission", "setSurfaces", ("Surfaces loaded from cache"));
+    } else {
+        memset((void *)mdpoints_, 0, mmax_m_all * sizeof(floodPointDesc));
+    }
+
+    for (size_t i = 0; !fromCache && i < seeds.size(); ++i) {
+        int x = static_cast<int>(seeds[i]) % mmax_x_;
+        int y = static_cast<int>(seeds[i]) % mmax_m_xy / mmax_x_;
+        int z = static_cast<int>(seeds[i]) / mmax_m_xy;
         if (mdpoints_[x + y * mmax_x_ + z * mmax_m_xy].bfNodeDesc == m_fdNotDefined) {
             WorldPoint stodef;
             std::vector<WorldPoint> vtodefine;
@@ -2187,10 +2412,27 @@ bool Mission::setSurfaces() {
 
     printf("flood walkables %i\n", cw);
 #endif
+    for (size_t i = 0; i < misplacedPeds.size(); ++i) {
+        // TODO : check on all maps those peds correct position
+        misplacedPeds[i]->setTileZ(mmax_z_ - 1);
+    }
+
+    if (!fromCache) {
+        PathSurfacesCache::save(p_map_->id(), mmax_x_, mmax_y_, mmax_z_,
+            inputsCrc, mdpoints_);
+    }
+    // the working copy is made once here, after each path search only
+    // the nodes touched by the flood are restored (see resetFloodWorkspace())
+    memcpy((void *)mdpoints_cp_, (void *)mdpoints_,
+        mmax_m_all * sizeof(floodPointDesc));
+    flood_base_nodes_.reserve(8192);
+    flood_target_nodes_.reserve(8192);
+    regionGraph_.build(mdpoints_, mmax_x_, mmax_y_, mmax_z_);
     return true;
 }
 
 void Mission::clrSurfaces() {
+    regionGraph_.clear();
 
     if(mtsurfaces_ != NULL) {
         free(mtsurfaces_);
@@ -2206,6 +2448,54 @@ void Mission::clrSurfaces() {
     }
 }
 
+/*!
+ * Every node changed by PedInstance::floodMap() is registered in
+ * flood_base_nodes_ or flood_target_nodes_. Restoring only those nodes from
+ * mdpoints_ keeps the cost of a path search proportional to the number of
+ * explored tiles instead of the map volume.
+ */
+void Mission::resetFloodWorkspace() {
+    for (std::vector<toSetDesc>::iterator it = flood_base_nodes_.begin();
+        it != flood_base_nodes_.end(); ++it)
+    {
+        *(it->pNode) = mdpoints_[it->pNode - mdpoints_cp_];
+    }
+    for (std::vector<toSetDesc>::iterator it = flood_target_nodes_.begin();
+        it != flood_target_nodes_.end(); ++it)
+    {
+        *(it->pNode) = mdpoints_[it->pNode - mdpoints_cp_];
+    }
+    for (std::vector<uint32>::iterator it = flood_fence_nodes_.begin();
+        it != flood_fence_nodes_.end(); ++it)
+    {
+        mdpoints_cp_[*it] = mdpoints_[*it];
+    }
+    flood_base_nodes_.clear();
+    flood_target_nodes_.clear();
+    flood_fence_nodes_.clear();
+}
+
+/*!
+ * Nodes that surround the corridor found by the region graph lose their
+ * walkable flag in mdpoints_cp_, so the flood cannot leave the corridor.
+ * They are restored by resetFloodWorkspace().
+ * \param baseIndex Index of the start node
+ * \param targetIndex Index of the destination node
+ * \return kCorridorUnreachable if no path exists between the nodes.
+ */
+PathRegionGraph::CorridorStatus Mission::closeFloodOutsideCorridor(uint32 baseIndex, uint32 targetIndex) {
+    PathRegionGraph::CorridorStatus status =
+        regionGraph_.findCorridor(baseIndex, targetIndex, flood_fence_nodes_);
+
+    for (std::vector<uint32>::iterator it = flood_fence_nodes_.begin();
+        it != flood_fence_nodes_.end(); ++it)
+    {
+        mdpoints_cp_[*it].bfNodeDesc &= (0xFF ^ m_fdWalkable);
+    }
+
+    return status;
+}
+
 /*!
  * Uses isometric coordinates transformation to find walkable tile,
  * starting from top.
@@ -2430,16 +2720,87 @@ bool Mission::getWalkableClosestByZ(TilePoint &mtp) {
     return found;
 }
 
+/*!
+ * Returns true if the object can block a shot coming from pOrigin.
+ * \param pCandidate The object to test
+ * \param pOrigin The shooter (can be null)
+ * \param pShooterVehicle The vehicle the shooter is in (can be null)
+ */
+static bool canBlockShot(MapObject *pCandidate, const ShootableMapObject *pOrigin,
+        const Vehicle *pShooterVehicle) {
+    switch (pCandidate->nature()) {
+    case MapObject::kNatureStatic:
+        return !static_cast<Static *>(pCandidate)->isExcludedFromBlockers();
+    case MapObject::kNatureVehicle:
+        return pCandidate != pShooterVehicle;
+    case MapObject::kNaturePed:
+    {
+        PedInstance *pPed = static_cast<PedInstance *>(pCandidate);
+        return pPed->isAlive() && pPed != pOrigin && pPed->inVehicle() == NULL;
+    }
+    case MapObject::kNatureWeapon:
+        return !static_cast<WeaponInstance *>(pCandidate)->hasOwner();
+    default:
+        return false;
+    }
+}
+
+/*!
+ * Finds the objects that can block a shot on one of the lines from
+ * originLoc to the targets. The result can be given to
+ * checkIfBlockersInShootingLine() for each line, so that the objects
+ * around all lines are searched only once.
+ * Objects must not move or change between this call and the checks.
+ * \param originLoc Start of all lines
+ * \param targets End of each line
+ * \param pOrigin The shooter (can be null)
+ * \param candidates The objects found are added to this list
+ */
+void Mission::findShotBlockerCandidates(const WorldPoint &originLoc,
+        const std::vector<WorldPoint> &targets, const ShootableMapObject *pOrigin,
+        std::vector<MapObject *> &candidates) {
+    // lines are included in the box around the origin and all targets
+    WorldPoint lowPt = originLoc;
+    WorldPoint highPt = originLoc;
+    for (size_t i = 0; i < targets.size(); ++i) {
+        lowPt.x = std::min(lowPt.x, targets[i].x);
+        lowPt.y = std::min(lowPt.y, targets[i].y);
+        lowPt.z = std::min(lowPt.z, targets[i].z);
+        highPt.x = std::max(highPt.x, targets[i].x);
+        highPt.y = std::max(highPt.y, targets[i].y);
+        highPt.z = std::max(highPt.z, targets[i].z);
+    }
+
+    const Vehicle *pShooterVehicle = NULL;
+    if (pOrigin && pOrigin->is(MapObject::kNaturePed)) {
+        pShooterVehicle = static_cast<const PedInstance *>(pOrigin)->inVehicle();
+    }
+
+    blockerCandidates_.clear();
+    objectGrid_.findAlongSegment(lowPt, highPt,
+        MapObject::kNatureStatic | MapObject::kNatureVehicle |
+        MapObject::kNaturePed | MapObject::kNatureWeapon, blockerCandidates_);
+    for (size_t i = 0; i < blockerCandidates_.size(); ++i) {
+        if (canBlockShot(blockerCandidates_[i], pOrigin, pShooterVehicle)) {
+            candidates.push_back(blockerCandidates_[i]);
+        }
+    }
+}
+
 /*!
 * This function looks for blockers - statics, vehicles, peds, weapons
+* \param pCandidates If not null, only those objects are tested (see
+*   findShotBlockerCandidates()). Else objects along the line are searched.
 */
 MapObject * Mission::checkBlockedByObject(WorldPoint * pStartPt, WorldPoint * pEndPt,
-        double *dist, const ShootableMapObject *pOrigin) {
+        double *dist, const ShootableMapObject *pOrigin,
+        const std::vector<MapObject *> *pCandidates) {
     // TODO: calculating closest blocker first? (start point can be closer though)
     double inc_xyz[3];
     inc_xyz[0] = (pEndPt->x - pStartPt->x) / (*dist);
     inc_xyz[1] = (pEndPt->y - pStartPt->y) / (*dist);
     inc_xyz[2] = (pEndPt->z - pStartPt->z) / (*dist);
+
     WorldPoint copyStartPt = *pStartPt;
     WorldPoint copyEndPt = *pEndPt;
     WorldPoint blockStartPt;
@@ -2447,18 +2808,40 @@ MapObject * Mission::checkBlockedByObject(WorldPoint * pStartPt, WorldPoint * pE
     double closest = *dist;
     MapObject *pBlocker = NULL;
 
-    for (unsigned int i = 0; i < statics_.size(); ++i) {
-        Static * s_blocker = statics_[i];
-        if (s_blocker->isExcludedFromBlockers())
-            continue;
-        if (s_blocker->isBlocker(&copyStartPt, &copyEndPt, inc_xyz)) {
+    if (pCandidates == NULL) {
+        // if shooter is a Ped and is shooting from a vehicle,
+        // then skip that vehicle in the search
+        const Vehicle *pShooterVehicle = NULL;
+        if (pOrigin && pOrigin->is(MapObject::kNaturePed)) {
+            const PedInstance *pPed = static_cast<const PedInstance *>(pOrigin);
+            pShooterVehicle = pPed->inVehicle(); // can be null
+        }
+
+        // only objects close to the path are tested
+        blockerCandidates_.clear();
+        objectGrid_.findAlongSegment(*pStartPt, *pEndPt,
+            MapObject::kNatureStatic | MapObject::kNatureVehicle |
+            MapObject::kNaturePed | MapObject::kNatureWeapon, blockerCandidates_);
+        size_t nbCandidates = 0;
+        for (size_t i = 0; i < blockerCandidates_.size(); ++i) {
+            if (canBlockShot(blockerCandidates_[i], pOrigin, pShooterVehicle)) {
+                blockerCandidates_[nbCandidates++] = blockerCandidates_[i];
+            }
+        }
+        blockerCandidates_.resize(nbCandidates);
+        pCandidates = &blockerCandidates_;
+    }
+
+    for (size_t i = 0; i < pCandidates->size(); ++i) {
+        MapObject *pCandidate = (*pCandidates)[i];
+        if (pCandidate->isBlocker(&copyStartPt, &copyEndPt, inc_xyz)) {
             int cx = pStartPt->x - copyStartPt.x;
             int cy = pStartPt->y - copyStartPt.y;
             int cz = pStartPt->z - copyStartPt.z;
             double dist_blocker = sqrt((double) (cx * cx + cy * cy + cz * cz));
             if (closest == -1 || dist_blocker < closest) {
                 closest = dist_blocker;
-                pBlocker = s_blocker;
+                pBlocker = pCandidate;
                 blockStartPt = copyStartPt;
                 blockEndPt = copyEndPt;
             }
@@ -2466,72 +2849,6 @@ MapObject * Mission::checkBlockedByObject(WorldPoint * pStartPt, WorldPoint * pE
             copyEndPt = *pEndPt;
         }
     }
-    // if shooter is a Ped and is shooting from a vehicle,
-    // then skip that vehicle in the search
-    Vehicle *pShooterVehicle = NULL;
-    if (pOrigin && pOrigin->is(MapObject::kNaturePed)) {
-        const PedInstance *pPed = static_cast<const PedInstance *>(pOrigin);
-        pShooterVehicle = pPed->inVehicle(); // can be null
-    }
-    for (unsigned int i = 0; i < vehicles_.size(); ++i) {
-        Vehicle * pVehicle = vehicles_[i];
-        if (pVehicle != pShooterVehicle) {
-            if (pVehicle->isBlocker(&copyStartPt, &copyEndPt, inc_xyz)) {
-                int cx = pStartPt->x - copyStartPt.x;
-                int cy = pStartPt->y - copyStartPt.y;
-                int cz = pStartPt->z - copyStartPt.z;
-                double dist_blocker = sqrt((double) (cx * cx + cy * cy + cz * cz));
-                if (closest == -1 || dist_blocker < closest) {
-                    closest = dist_blocker;
-                    pBlocker = pVehicle;
-                    blockStartPt = copyStartPt;
-                    blockEndPt = copyEndPt;
-                }
-                copyStartPt = *pStartPt;
-                copyEndPt = *pEndPt;
-            }
-        }
-    }
-
-    for (unsigned int i = 0; i < peds_.size(); ++i) {
-        PedInstance * p_blocker = peds_[i];
-        if (p_blocker->isAlive() && p_blocker != pOrigin && p_blocker->inVehicle() == NULL) {
-            if (p_blocker->isBlocker(&copyStartPt, &copyEndPt, inc_xyz)) {
-                int cx = pStartPt->x - copyStartPt.x;
-                int cy = pStartPt->y - copyStartPt.y;
-                int cz = pStartPt->z - copyStartPt.z;
-                double dist_blocker = sqrt((double) (cx * cx + cy * cy + cz * cz));
-                if (closest == -1 || dist_blocker < closest) {
-                    closest = dist_blocker;
-                    pBlocker = p_blocker;
-                    blockStartPt = copyStartPt;
-                    blockEndPt = copyEndPt;
-                }
-                copyStartPt = *pStartPt;
-                copyEndPt = *pEndPt;
-            }
-        }
-    }
-
-    for (unsigned int i = 0; i < weaponsOnGround_.size(); ++i) {
-        WeaponInstance *pWeapon = weaponsOnGround_[i];
-        if (!pWeapon->hasOwner()) {
-            if (pWeapon->isBlocker(&copyStartPt, &copyEndPt, inc_xyz)) {
-                int cx = pStartPt->x - copyStartPt.x;
-                int cy = pStartPt->y - copyStartPt.y;
-                int cz = pStartPt->z - copyStartPt.z;
-                double dist_blocker = sqrt((double) (cx * cx + cy * cy + cz * cz));
-                if (closest == -1 || dist_blocker < closest) {
-                    closest = dist_blocker;
-                    pBlocker = pWeapon;
-                    blockStartPt = copyStartPt;
-                    blockEndPt = copyEndPt;
-                }
-                copyStartPt = *pStartPt;
-                copyEndPt = *pEndPt;
-            }
-        }
-    }
     if (pBlocker != NULL) {
         *pStartPt = blockStartPt;
         *pEndPt = blockEndPt;
@@ -2544,6 +2861,55 @@ MapObject * Mission::checkBlockedByObject(WorldPoint * pStartPt, WorldPoint * pE
 /*!
  * Verify that the path from originPosW to pTargetPosW is not blocked by a tile.
  * If such a tile exists, pTargetPosW is updated with the position of the blocking tile.
+ * Results are kept until the next call to clearVisibilityCache(), so the
+ * same line is traced only once per tick.
+ * \param originPosW Path starting point
+ * \param pTargetPosW Path end point
+ * \param updateLoc Set to true to update pTargetPosW when blocking tile is found
+ * \param distanceMax Maximum distance we cannot cross. If distanceMax is
+ *   reached before pTargetPosW, then path is stopped.
+ * \param pInitialDistance This is the distance between origin and initial target position
+ * \return a bitmask indicating the type of result (see traceBlockingTiles())
+ */
+uint8 Mission::checkBlockedByTile(const WorldPoint & originPosW, WorldPoint *pTargetPosW,
+                                  bool updateLoc, double distanceMax, double *pInitialDistance) {
+    VisibilityCache::Result result;
+    if (!visibilityCache_.find(originPosW, *pTargetPosW, distanceMax, &result)) {
+        result.reachedPosW = *pTargetPosW;
+        result.distance = 0;
+        result.mask = traceBlockingTiles(originPosW, &result.reachedPosW, true,
+                                         distanceMax, &result.distance);
+        visibilityCache_.store(originPosW, *pTargetPosW, distanceMax, result);
+    }
+
+    if (result.mask != kBMaskBlockerTargetOutOfMap) {
+        if (updateLoc) {
+            *pTargetPosW = result.reachedPosW;
+        }
+        if (pInitialDistance) {
+            *pInitialDistance = result.distance;
+        }
+    }
+
+    return result.mask;
+}
+
+/*!
+ * Checks the tile blocking for a list of lines.
+ * Lines that appear several times in the list are traced once.
+ * \param queries The lines to check : the result field is set for each one
+ */
+void Mission::checkVisibility(std::vector<VisibilityQuery> &queries) {
+    for (std::vector<VisibilityQuery>::iterator it = queries.begin();
+        it != queries.end(); ++it) {
+        WorldPoint targetPosW = it->targetPosW;
+        it->result = checkBlockedByTile(it->originPosW, &targetPosW, false, it->distanceMax);
+    }
+}
+
+/*!
+ * Follows the path from originPosW to pTargetPosW to find a blocking tile.
+ * If such a tile exists, pTargetPosW is updated with the position of the blocking tile.
  * \param originPosW Path starting point
  * \param pTargetPosW Path end point
  * \param updateLoc Set to true to update pTargetPosW when blocking tile is found
@@ -2556,7 +2922,7 @@ MapObject * Mission::checkBlockedByObject(WorldPoint * pStartPt, WorldPoint * pE
  *      - 4b(16): blocker tile, "pTargetLoc" is set
  *      - 5b(32): out of visible reach
  */
-uint8 Mission::checkBlockedByTile(const WorldPoint & originPosW, WorldPoint *pTargetPosW,
+uint8 Mission::traceBlockingTiles(const WorldPoint & originPosW, WorldPoint *pTargetPosW,
                                   bool updateLoc, double distanceMax, double *pInitialDistance) {
     // TODO: some objects mid point is higher then map z
     assert(distanceMax >= 0);
@@ -2585,10 +2951,6 @@ uint8 Mission::checkBlockedByTile(const WorldPoint & originPosW, WorldPoint *pTa
     if (distanceToTarget == 0)
         return block_mask;
 
-    double sx = (double) cx;
-    double sy = (double) cy;
-    double sz = (double) cz;
-
     if (distanceToTarget >= distanceMax) {
         // the distance we have to cross (distanceToTarget) is higher than the maximum
         // distance we are allowed to cross (distanceMax)
@@ -2606,86 +2968,90 @@ uint8 Mission::checkBlockedByTile(const WorldPoint & originPosW, WorldPoint *pTa
         distanceToTarget = distanceMax;
     }
 
-    // NOTE: these values are less then 1.
-    // If they are incremented, time required to check range will be shorter but less precise check,
-    // If decremented longer but more precise.
-    // Increment is (n * 8)
-    double incrX = ((tmpTargetWLoc.x - cx) * 8) / distanceToTarget;
-    double incrY = ((tmpTargetWLoc.y - cy) * 8) / distanceToTarget;
-    double incrZ = ((tmpTargetWLoc.z - cz) * 8) / distanceToTarget;
-
-    int oldx = cx / 256;
-    int oldy = cy / 256;
-    int oldz = cz / 128;
-    double dist_close = distanceToTarget;
-    // look note before, should be same increment
-    double dist_dec = 1.0 * 8;
-
-    while (dist_close > dist_dec) {
-        int nx = (int)sx / 256;
-        int ny = (int)sy / 256;
-        int nz = (int)sz / 128;
-        unsigned char twd = mtsurfaces_[nx + ny * mmax_x_
-            + nz * mmax_m_xy];
-        if (oldx != nx || oldy != ny || oldz != nz
-            || (twd >= 0x01 && twd <= 0x04))
-        {
-            if (!(twd == 0x00 || twd == 0x0C || twd == 0x10)) {
-                bool is_blocked = false;
-                int offz = (int)sz % 128;
-                switch (twd) {
-                    case 0x01:
-                        if (offz <= (127 - (((int)sy % 256) >> 1)))
-                            is_blocked = true;
-                        break;
-                    case 0x02:
-                        if (offz <= (((int)sy % 256) >> 1))
-                            is_blocked = true;
-                        break;
-                    case 0x03:
-                        if (offz <= (((int)sx % 256) >> 1))
-                            is_blocked = true;
-                        break;
-                    case 0x04:
-                        if (offz <= (127 - (((int)sx % 256) >> 1)))
-                            is_blocked = true;
-                        break;
-                    default:
-                        is_blocked = true;
-                }
-                if (is_blocked) {
-                    sx -= incrX;
-                    sy -= incrY;
-                    sz -= incrZ;
-                    double dsx = sx - (double)cx;
-                    double dsy = sy - (double)cy;
-                    double dsz = sz - (double)cz;
-                    tmpTargetWLoc.x = (int)sx;
-                    tmpTargetWLoc.y = (int)sy;
-                    tmpTargetWLoc.z = (int)sz;
-                    dist_close = sqrt(dsx * dsx + dsy * dsy + dsz * dsz);
-                    // set mask to indicate path is blocked by a tile
-                    if (block_mask == 1)
-                        block_mask = 16;
-                    else
-                        block_mask |= 16;
-                    if (updateLoc) {
-                        pTargetPosW->x = (int)sx;
-                        pTargetPosW->y = (int)sy;
-                        pTargetPosW->z = (int)sz;
-                    }
-                    break;
-                }
+    // The path is followed tile by tile. The last kTileCheckStep units
+    // before the target are not checked as the target is there.
+    double dir[3];
+    dir[0] = (tmpTargetWLoc.x - cx) / distanceToTarget;
+    dir[1] = (tmpTargetWLoc.y - cy) / distanceToTarget;
+    dir[2] = (tmpTargetWLoc.z - cz) / distanceToTarget;
+    double tEnd = distanceToTarget - kTileCheckStep;
+
+    const int tileSize[3] = {256, 256, 128};
+    const int maxTile[3] = {mmax_x_, mmax_y_, mmax_z_};
+    double origin[3] = {(double) cx, (double) cy, (double) cz};
+    int tile[3] = {cx / 256, cy / 256, cz / 128};
+    int step[3];
+    // distance to cross a whole tile on each axis
+    double tDelta[3];
+    // distance at which the next tile on each axis is entered
+    double tNext[3];
+    for (int i = 0; i < 3; i++) {
+        if (dir[i] > 0) {
+            step[i] = 1;
+            tDelta[i] = tileSize[i] / dir[i];
+            tNext[i] = ((tile[i] + 1) * tileSize[i] - origin[i]) / dir[i];
+        } else if (dir[i] < 0) {
+            step[i] = -1;
+            tDelta[i] = -tileSize[i] / dir[i];
+            tNext[i] = (tile[i] * tileSize[i] - origin[i]) / dir[i];
+        } else {
+            step[i] = 0;
+            tDelta[i] = tNext[i] = distanceToTarget + 1;
+        }
+    }
+
+    double tEnter = 0;
+    bool startingTile = true;
+    bool blocked = false;
+    while (tEnter < tEnd) {
+        if (tile[0] < 0 || tile[0] >= maxTile[0] || tile[1] < 0
+            || tile[1] >= maxTile[1] || tile[2] < 0 || tile[2] >= maxTile[2]) {
+            break;
+        }
+
+        int axis = 0;
+        if (tNext[1] < tNext[axis])
+            axis = 1;
+        if (tNext[2] < tNext[axis])
+            axis = 2;
+        double tExit = tNext[axis];
+
+        uint8 twd = mtsurfaces_[tile[0] + tile[1] * mmax_x_ + tile[2] * mmax_m_xy];
+        if (twd >= 0x01 && twd <= 0x04) {
+            // stairs block only below their slope
+            double tHit;
+            if (hitOnStairs(twd, origin, dir, tile, tEnter,
+                            std::min(tExit, tEnd), &tHit)) {
+                tEnter = tHit;
+                blocked = true;
+            }
+        } else if (!startingTile && !(twd == 0x00 || twd == 0x0C || twd == 0x10)) {
+            // the starting tile never blocks
+            blocked = true;
+        }
+
+        if (blocked) {
+            // blocker position is taken just before the tile
+            double tBlock = std::max(0.0, tEnter - kTileCheckStep);
+            tmpTargetWLoc.x = (int)(origin[0] + dir[0] * tBlock);
+            tmpTargetWLoc.y = (int)(origin[1] + dir[1] * tBlock);
+            tmpTargetWLoc.z = (int)(origin[2] + dir[2] * tBlock);
+            // set mask to indicate path is blocked by a tile
+            if (block_mask == 1)
+                block_mask = 16;
+            else
+                block_mask |= 16;
+            if (updateLoc) {
+                *pTargetPosW = tmpTargetWLoc;
             }
-            oldx = nx;
-            oldy = ny;
-            oldz = nz;
+            break;
         }
-        sx += incrX;
-        sy += incrY;
-        sz += incrZ;
-        dist_close -= dist_dec;
-    } // end while
+
+        tile[axis] += step[axis];
+        tEnter = tExit;
+        startingTile = false;
+        tNext[axis] += tDelta[axis];
+    }
 
     return block_mask;
 }
@@ -2699,6 +3065,7 @@ uint8 Mission::checkBlockedByTile(const WorldPoint & originPosW, WorldPoint *pTa
  * \param maxr maximum distance we can run
  * \param distTo
  * \param pOrigin
+ * \param pCandidates Objects that can block the line (see checkBlockedByObject())
  * \return mask where bits are:
  * - 0b : target in range(1)
  * - 1b : blocker is object, "t" is set(2)
@@ -2711,7 +3078,8 @@ uint8 Mission::checkBlockedByTile(const WorldPoint & originPosW, WorldPoint *pTa
 */
 uint8 Mission::checkIfBlockersInShootingLine(const WorldPoint & originLoc, ShootableMapObject ** pTarget,
     WorldPoint *pTargetPosW, bool setBlocker, bool checkTileOnly, double maxr,
-    double * distTo, const ShootableMapObject *pOrigin)
+    double * distTo, const ShootableMapObject *pOrigin,
+    const std::vector<MapObject *> *pCandidates)
 {
     // search for a tile blocking the path towards the target
     // tmp will hold the updated position after that search
@@ -2744,7 +3112,8 @@ uint8 Mission::checkIfBlockersInShootingLine(const WorldPoint & originLoc, Shoot
     int dy = tmpPosW.y - originLoc.y;
     int dz = tmpPosW.z - originLoc.z;
     double distToBlocker = sqrt((double)(dx * dx + dy * dy + dz * dz));
-    MapObject *blockerObj = checkBlockedByObject(&tmpOrigin, &tmpEnd, &distToBlocker, pOrigin);
+    MapObject *blockerObj = checkBlockedByObject(&tmpOrigin, &tmpEnd, &distToBlocker,
+        pOrigin, pCandidates);
 
     if (blockerObj) {
         if (bfBlockerFound == 1)
@@ -0,0 +1,172 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include "fs-kernel/model/objectgrid.h"
+
+#include <algorithm>
+
+#include "fs-kernel/model/mapobject.h"
+
+const int MapObjectGrid::kNoCell = -1;
+const int MapObjectGrid::kCellMargin = 1;
+
+MapObjectGrid::MapObjectGrid() {
+    maxX_ = 0;
+    maxY_ = 0;
+    maxExtent_ = 0;
+}
+
+void MapObjectGrid::init(int maxX, int maxY) {
+    clear();
+    maxX_ = maxX;
+    maxY_ = maxY;
+    cells_.resize(static_cast<size_t>(maxX * maxY));
+}
+
+/*!
+ * Objects that were in the grid are not told they are removed : the
+ * grid must be cleared only when those objects are also cleared.
+ */
+void MapObjectGrid::clear() {
+    cells_.clear();
+    maxX_ = 0;
+    maxY_ = 0;
+    maxExtent_ = 0;
+}
+
+/*!
+ * Objects outside the map are stored in the closest tile of the map.
+ */
+int MapObjectGrid::cellOf(int tx, int ty) const {
+    tx = std::max(0, std::min(tx, maxX_ - 1));
+    ty = std::max(0, std::min(ty, maxY_ - 1));
+    return tx + ty * maxX_;
+}
+
+void MapObjectGrid::insert(MapObject *pObject) {
+    if (cells_.empty() || pObject->gridCell() != kNoCell) {
+        return;
+    }
+
+    int extent = (std::max(pObject->sizeX(), pObject->sizeY()) + 255) / 256;
+    maxExtent_ = std::max(maxExtent_, extent);
+
+    int cell = cellOf(pObject->tileX(), pObject->tileY());
+    cells_[static_cast<size_t>(cell)].push_back(pObject);
+    pObject->setGridCell(cell);
+}
+
+void MapObjectGrid::remove(MapObject *pObject) {
+    int cell = pObject->gridCell();
+    if (cell == kNoCell || cells_.empty()) {
+        return;
+    }
+
+    std::vector<MapObject *> &bucket = cells_[static_cast<size_t>(cell)];
+    for (size_t i = 0; i < bucket.size(); i++) {
+        if (bucket[i] == pObject) {
+            bucket[i] = bucket.back();
+            bucket.pop_back();
+            break;
+        }
+    }
+    pObject->setGridCell(kNoCell);
+}
+
+void MapObjectGrid::update(MapObject *pObject) {
+    if (pObject->gridCell() == kNoCell) {
+        return;
+    }
+
+    if (cellOf(pObject->tileX(), pObject->tileY()) != pObject->gridCell()) {
+        remove(pObject);
+        insert(pObject);
+    }
+}
+
+/*!
+ * \param minTx Smallest tile on X
+ * \param minTy Smallest tile on Y
+ * \param maxTx Biggest tile on X (included)
+ * \param maxTy Biggest tile on Y (included)
+ * \param natureMask Bitmask of MapObject::ObjectNature to look for
+ * \param objects Found objects are added to this list
+ */
+void MapObjectGrid::findInTileArea(int minTx, int minTy, int maxTx, int maxTy,
+        int natureMask, std::vector<MapObject *> &objects) const {
+    if (cells_.empty()) {
+        return;
+    }
+
+    minTx = std::max(0, minTx - kCellMargin);
+    minTy = std::max(0, minTy - kCellMargin);
+    maxTx = std::min(maxX_ - 1, maxTx + kCellMargin);
+    maxTy = std::min(maxY_ - 1, maxTy + kCellMargin);
+
+    for (int ty = minTy; ty <= maxTy; ty++) {
+        for (int tx = minTx; tx <= maxTx; tx++) {
+            const std::vector<MapObject *> &bucket =
+                cells_[static_cast<size_t>(tx + ty * maxX_)];
+            for (std::vector<MapObject *>::const_iterator it = bucket.begin();
+                it != bucket.end(); ++it) {
+                if ((*it)->nature() & natureMask) {
+                    objects.push_back(*it);
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * Returns all objects whose bounding box may be in the range, so big
+ * objects whose tile is outside the range are also returned.
+ * \param center Center of the area
+ * \param range Distance from the center
+ * \param natureMask Bitmask of MapObject::ObjectNature to look for
+ * \param objects Found objects are added to this list
+ */
+void MapObjectGrid::findInRange(const WorldPoint &center, int32 range,
+        int natureMask, std::vector<MapObject *> &objects) const {
+    findInTileArea((center.x - range) / 256 - maxExtent_,
+                   (center.y - range) / 256 - maxExtent_,
+                   (center.x + range) / 256 + maxExtent_,
+                   (center.y + range) / 256 + maxExtent_,
+                   natureMask, objects);
+}
+
+/*!
+ * Returns all objects whose bounding box may cross the segment.
+ * \param from Start of the segment
+ * \param to End of the segment
+ * \param natureMask Bitmask of MapObject::ObjectNature to look for
+ * \param objects Found objects are added to this list
+ */
+void MapObjectGrid::findAlongSegment(const WorldPoint &from, const WorldPoint &to,
+        int natureMask, std::vector<MapObject *> &objects) const {
+    int minTx = std::min(from.x, to.x) / 256 - maxExtent_;
+    int minTy = std::min(from.y, to.y) / 256 - maxExtent_;
+    int maxTx = std::max(from.x, to.x) / 256 + maxExtent_;
+    int maxTy = std::max(from.y, to.y) / 256 + maxExtent_;
+
+    findInTileArea(minTx, minTy, maxTx, maxTy, natureMask, objects);
+}
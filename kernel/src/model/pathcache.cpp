@@ -0,0 +1,179 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include "fs-kernel/model/pathcache.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sstream>
+#include <iomanip>
+
+#include "fs-utils/crc/ccrc32.h"
+#include "fs-utils/io/file.h"
+#include "fs-utils/log/log.h"
+
+const uint32 PathSurfacesCache::kVersion = 1;
+
+namespace {
+    const char kMagic[4] = {'F', 'S', 'P', 'C'};
+}
+
+/*!
+ * \param pSurfaces Walk data of every tile of the map
+ * \param nbSurfaces Number of tiles
+ * \param pSeeds Index of the tiles from which the surfaces are flooded
+ * \param nbSeeds Number of seeds
+ * \return the checksum
+ */
+uint32 PathSurfacesCache::inputsChecksum(const uint8 *pSurfaces, size_t nbSurfaces,
+        const uint32 *pSeeds, size_t nbSeeds) {
+    CCRC32 crc32;
+    unsigned int crc = 0xffffffff;
+    crc32.PartialCRC(&crc, pSurfaces, nbSurfaces);
+    crc32.PartialCRC(&crc, reinterpret_cast<const unsigned char *>(pSeeds),
+            nbSeeds * sizeof(uint32));
+    return crc ^ 0xffffffff;
+}
+
+bool PathSurfacesCache::cacheFilePath(uint16 mapId, std::string &path) {
+    std::ostringstream filename;
+    filename << "map" << std::setfill('0') << std::setw(2) << mapId << ".path";
+
+    fs::path fullPath;
+    if (!File::getCacheFullPath(filename.str(), fullPath)) {
+        return false;
+    }
+    path.assign(fullPath.string());
+    return true;
+}
+
+void PathSurfacesCache::fillHeader(Header &header, uint16 mapId, int maxX, int maxY,
+        int maxZ, uint32 inputsCrc) {
+    memset(&header, 0, sizeof(Header));
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.pointSize = sizeof(floodPointDesc);
+    header.mapId = mapId;
+    header.maxX = static_cast<uint32>(maxX);
+    header.maxY = static_cast<uint32>(maxY);
+    header.maxZ = static_cast<uint32>(maxZ);
+    header.inputsCrc = inputsCrc;
+}
+
+/*!
+ * The points are read directly in the given array.
+ * \param mapId Id of the map
+ * \param maxX Dimension of the map
+ * \param maxY Dimension of the map
+ * \param maxZ Dimension of the map
+ * \param inputsCrc Checksum of the inputs (see inputsChecksum())
+ * \param pPoints Array of maxX * maxY * maxZ points
+ * \return False if there is no valid file for those inputs. In that case,
+ * the content of pPoints is undefined.
+ */
+bool PathSurfacesCache::load(uint16 mapId, int maxX, int maxY, int maxZ,
+        uint32 inputsCrc, floodPointDesc *pPoints) {
+    std::string path;
+    if (!cacheFilePath(mapId, path)) {
+        return false;
+    }
+
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (fp == NULL) {
+        return false;
+    }
+
+    Header expected, header;
+    fillHeader(expected, mapId, maxX, maxY, maxZ, inputsCrc);
+    size_t dataSize = static_cast<size_t>(maxX * maxY * maxZ) * sizeof(floodPointDesc);
+
+    bool loaded = fread(&header, sizeof(Header), 1, fp) == 1
+        && memcmp(header.magic, expected.magic, sizeof(kMagic)) == 0
+        && header.version == expected.version
+        && header.pointSize == expected.pointSize
+        && header.mapId == expected.mapId
+        && header.maxX == expected.maxX
+        && header.maxY == expected.maxY
+        && header.maxZ == expected.maxZ
+        && header.inputsCrc == expected.inputsCrc
+        && fread(pPoints, dataSize, 1, fp) == 1;
+    fclose(fp);
+
+    if (loaded) {
+        CCRC32 crc32;
+        loaded = crc32.FullCRC(reinterpret_cast<const unsigned char *>(pPoints), dataSize) == header.dataCrc;
+        if (!loaded) {
+            FSERR(Log::k_FLG_IO, "PathSurfacesCache", "load", ("Corrupted cache file %s\n", path.c_str()));
+        }
+    }
+
+    return loaded;
+}
+
+/*!
+ * The file is first written with a temporary name and then renamed, so
+ * an interrupted save does not leave a partial file.
+ * \param mapId Id of the map
+ * \param maxX Dimension of the map
+ * \param maxY Dimension of the map
+ * \param maxZ Dimension of the map
+ * \param inputsCrc Checksum of the inputs (see inputsChecksum())
+ * \param pPoints Array of maxX * maxY * maxZ points
+ * \return True if file was saved
+ */
+bool PathSurfacesCache::save(uint16 mapId, int maxX, int maxY, int maxZ,
+        uint32 inputsCrc, const floodPointDesc *pPoints) {
+    std::string path;
+    if (!cacheFilePath(mapId, path)) {
+        return false;
+    }
+    std::string tmpPath = path + ".tmp";
+
+    FILE *fp = fopen(tmpPath.c_str(), "wb");
+    if (fp == NULL) {
+        FSERR(Log::k_FLG_IO, "PathSurfacesCache", "save", ("Cannot create cache file %s\n", tmpPath.c_str()));
+        return false;
+    }
+
+    Header header;
+    fillHeader(header, mapId, maxX, maxY, maxZ, inputsCrc);
+    size_t dataSize = static_cast<size_t>(maxX * maxY * maxZ) * sizeof(floodPointDesc);
+    CCRC32 crc32;
+    header.dataCrc = crc32.FullCRC(reinterpret_cast<const unsigned char *>(pPoints), dataSize);
+
+    bool saved = fwrite(&header, sizeof(Header), 1, fp) == 1
+        && fwrite(pPoints, dataSize, 1, fp) == 1;
+    saved = (fclose(fp) == 0) && saved;
+
+    std::error_code ec;
+    if (saved) {
+        fs::rename(tmpPath, path, ec);
+        saved = !ec;
+    }
+    if (!saved) {
+        FSERR(Log::k_FLG_IO, "PathSurfacesCache", "save", ("Cannot write cache file %s\n", path.c_str()));
+        fs::remove(tmpPath, ec);
+    }
+
+    return saved;
+}
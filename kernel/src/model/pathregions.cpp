@@ -0,0 +1,343 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+#include "fs-kernel/model/pathregions.h"
+
+#include <algorithm>
+
+#include "fs-utils/log/log.h"
+
+const int PathRegionGraph::kClusterSize = 8;
+const size_t PathRegionGraph::kRouteCacheSize = 128;
+const uint32 PathRegionGraph::kNoRegion = 0xFFFFFFFF;
+
+PathRegionGraph::PathRegionGraph() {
+    pPoints_ = NULL;
+    maxX_ = 0;
+    maxY_ = 0;
+    maxXY_ = 0;
+    maxAll_ = 0;
+    currentStamp_ = 0;
+    cacheHits_ = 0;
+    cacheMisses_ = 0;
+}
+
+void PathRegionGraph::clear() {
+    pPoints_ = NULL;
+    nodeRegions_.clear();
+    regions_.clear();
+    regionStamps_.clear();
+    regionParents_.clear();
+    routesLru_.clear();
+    routesIndex_.clear();
+    currentStamp_ = 0;
+    cacheHits_ = 0;
+    cacheMisses_ = 0;
+}
+
+/*!
+ * Uses the same directions as PedInstance::floodMap() : dirh for z + 1,
+ * dirm for z and dirl for z - 1. Only walkable nodes are returned.
+ * \param nodeIndex Index of the node
+ * \param pNeighbours Array of at least 16 elements
+ * \return the number of neighbours
+ */
+int PathRegionGraph::nodeNeighbours(uint32 nodeIndex, uint32 *pNeighbours) const {
+    const floodPointDesc &node = pPoints_[nodeIndex];
+    int idx = static_cast<int>(nodeIndex);
+    int candidates[16];
+    int n = 0;
+
+    if (node.dirh != 0) {
+        if ((node.dirh & 0x01) == 0x01)
+            candidates[n++] = idx + maxX_ + maxXY_;
+        if ((node.dirh & 0x04) == 0x04)
+            candidates[n++] = idx + 1 + maxXY_;
+        if ((node.dirh & 0x10) == 0x10)
+            candidates[n++] = idx - maxX_ + maxXY_;
+        if ((node.dirh & 0x40) == 0x40)
+            candidates[n++] = idx - 1 + maxXY_;
+    }
+    if (node.dirl != 0) {
+        if ((node.dirl & 0x01) == 0x01)
+            candidates[n++] = idx + maxX_ - maxXY_;
+        if ((node.dirl & 0x04) == 0x04)
+            candidates[n++] = idx + 1 - maxXY_;
+        if ((node.dirl & 0x10) == 0x10)
+            candidates[n++] = idx - maxX_ - maxXY_;
+        if ((node.dirl & 0x40) == 0x40)
+            candidates[n++] = idx - 1 - maxXY_;
+    }
+    if (node.dirm != 0) {
+        if ((node.dirm & 0x01) == 0x01)
+            candidates[n++] = idx + maxX_;
+        if ((node.dirm & 0x02) == 0x02)
+            candidates[n++] = idx + 1 + maxX_;
+        if ((node.dirm & 0x04) == 0x04)
+            candidates[n++] = idx + 1;
+        if ((node.dirm & 0x08) == 0x08)
+            candidates[n++] = idx + 1 - maxX_;
+        if ((node.dirm & 0x10) == 0x10)
+            candidates[n++] = idx - maxX_;
+        if ((node.dirm & 0x20) == 0x20)
+            candidates[n++] = idx - 1 - maxX_;
+        if ((node.dirm & 0x40) == 0x40)
+            candidates[n++] = idx - 1;
+        if ((node.dirm & 0x80) == 0x80)
+            candidates[n++] = idx - 1 + maxX_;
+    }
+
+    int nbFound = 0;
+    for (int i = 0; i < n; ++i) {
+        if (candidates[i] >= 0 && candidates[i] < maxAll_
+            && (pPoints_[candidates[i]].bfNodeDesc & m_fdWalkable) != 0)
+        {
+            pNeighbours[nbFound++] = static_cast<uint32>(candidates[i]);
+        }
+    }
+    return nbFound;
+}
+
+/*!
+ * Regions are computed column by column, then the portals between
+ * regions are registered.
+ * \param pPoints The directions points of the mission (must live as long
+ * as the graph)
+ * \param maxX map width
+ * \param maxY map height
+ * \param maxZ map depth
+ */
+void PathRegionGraph::build(const floodPointDesc *pPoints, int maxX, int maxY, int maxZ) {
+    clear();
+    pPoints_ = pPoints;
+    maxX_ = maxX;
+    maxY_ = maxY;
+    maxXY_ = maxX * maxY;
+    maxAll_ = maxXY_ * maxZ;
+    nodeRegions_.assign(static_cast<size_t>(maxAll_), kNoRegion);
+
+    uint32 neighbours[16];
+    std::vector<uint32> toVisit;
+    toVisit.reserve(1024);
+
+    for (int cy = 0; cy < maxY_; cy += kClusterSize) {
+        for (int cx = 0; cx < maxX_; cx += kClusterSize) {
+            int endX = std::min(cx + kClusterSize, maxX_);
+            int endY = std::min(cy + kClusterSize, maxY_);
+            for (int z = 0; z < maxZ; ++z) {
+                for (int y = cy; y < endY; ++y) {
+                    for (int x = cx; x < endX; ++x) {
+                        uint32 start = static_cast<uint32>(x + y * maxX_ + z * maxXY_);
+                        if ((pPoints_[start].bfNodeDesc & m_fdWalkable) == 0
+                            || nodeRegions_[start] != kNoRegion)
+                        {
+                            continue;
+                        }
+                        // new region : every connected node of the cluster
+                        // belongs to it
+                        uint32 regionId = static_cast<uint32>(regions_.size());
+                        regions_.push_back(Region());
+                        nodeRegions_[start] = regionId;
+                        toVisit.push_back(start);
+                        while (!toVisit.empty()) {
+                            uint32 node = toVisit.back();
+                            toVisit.pop_back();
+                            int nb = nodeNeighbours(node, neighbours);
+                            for (int i = 0; i < nb; ++i) {
+                                int nx = static_cast<int>(neighbours[i]) % maxX_;
+                                int ny = (static_cast<int>(neighbours[i]) / maxX_) % maxY_;
+                                if (nx >= cx && nx < endX && ny >= cy && ny < endY
+                                    && nodeRegions_[neighbours[i]] == kNoRegion)
+                                {
+                                    nodeRegions_[neighbours[i]] = regionId;
+                                    toVisit.push_back(neighbours[i]);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Links between regions
+    for (uint32 node = 0; node < nodeRegions_.size(); ++node) {
+        uint32 region = nodeRegions_[node];
+        if (region == kNoRegion) {
+            continue;
+        }
+        int nb = nodeNeighbours(node, neighbours);
+        for (int i = 0; i < nb; ++i) {
+            uint32 other = nodeRegions_[neighbours[i]];
+            if (other != kNoRegion && other != region) {
+                regions_[region].portals.push_back(neighbours[i]);
+                regions_[region].neighbours.push_back(other);
+                regions_[other].neighbours.push_back(region);
+            }
+        }
+    }
+
+    for (std::vector<Region>::iterator it = regions_.begin(); it != regions_.end(); ++it) {
+        std::sort(it->neighbours.begin(), it->neighbours.end());
+        it->neighbours.erase(std::unique(it->neighbours.begin(), it->neighbours.end()),
+            it->neighbours.end());
+        std::sort(it->portals.begin(), it->portals.end());
+        it->portals.erase(std::unique(it->portals.begin(), it->portals.end()),
+            it->portals.end());
+    }
+
+    regionStamps_.assign(regions_.size(), 0);
+    regionParents_.assign(regions_.size(), kNoRegion);
+
+    LOG(Log::k_FLG_GAME, "PathRegionGraph", "build", ("%d regions created", static_cast<int>(regions_.size())));
+}
+
+/*!
+ * Breadth first search on the regions graph.
+ * \param fromRegion start region
+ * \param toRegion end region
+ * \param route list of regions from start to end. Empty if no route exists
+ */
+void PathRegionGraph::searchRoute(uint32 fromRegion, uint32 toRegion, Route &route) {
+    route.clear();
+    if (++currentStamp_ == 0) {
+        std::fill(regionStamps_.begin(), regionStamps_.end(), 0);
+        currentStamp_ = 1;
+    }
+
+    std::vector<uint32> toVisit;
+    toVisit.reserve(256);
+    toVisit.push_back(fromRegion);
+    regionStamps_[fromRegion] = currentStamp_;
+    regionParents_[fromRegion] = kNoRegion;
+
+    for (size_t i = 0; i < toVisit.size(); ++i) {
+        uint32 region = toVisit[i];
+        if (region == toRegion) {
+            for (uint32 r = toRegion; r != kNoRegion; r = regionParents_[r]) {
+                route.push_back(r);
+            }
+            return;
+        }
+        const std::vector<uint32> &neighbours = regions_[region].neighbours;
+        for (std::vector<uint32>::const_iterator it = neighbours.begin();
+            it != neighbours.end(); ++it)
+        {
+            if (regionStamps_[*it] != currentStamp_) {
+                regionStamps_[*it] = currentStamp_;
+                regionParents_[*it] = region;
+                toVisit.push_back(*it);
+            }
+        }
+    }
+}
+
+/*!
+ * As links between regions go both ways, the route from A to B is the
+ * same as the one from B to A : only one entry is kept for both.
+ */
+const PathRegionGraph::Route & PathRegionGraph::findRoute(uint32 fromRegion, uint32 toRegion) {
+    uint64 key = fromRegion < toRegion ?
+        (static_cast<uint64>(fromRegion) << 32) | toRegion :
+        (static_cast<uint64>(toRegion) << 32) | fromRegion;
+
+    std::map<uint64, std::list<RouteEntry>::iterator>::iterator found = routesIndex_.find(key);
+    if (found != routesIndex_.end()) {
+        cacheHits_++;
+        // move entry in front of the list
+        routesLru_.splice(routesLru_.begin(), routesLru_, found->second);
+        return found->second->second;
+    }
+
+    cacheMisses_++;
+    routesLru_.push_front(RouteEntry(key, Route()));
+    searchRoute(fromRegion, toRegion, routesLru_.front().second);
+    routesIndex_[key] = routesLru_.begin();
+
+    if (routesLru_.size() > kRouteCacheSize) {
+        routesIndex_.erase(routesLru_.back().first);
+        routesLru_.pop_back();
+    }
+
+    return routesLru_.front().second;
+}
+
+/*!
+ * The corridor is made of the regions on the route between the base
+ * and the target and the regions directly around them so the flood has
+ * room to find a short path.
+ * \param baseIndex index of the start node
+ * \param targetIndex index of the destination node
+ * \param fenceNodes filled with nodes outside the corridor that can be
+ * reached from it. The caller must close them before flooding.
+ * \return status of the search
+ */
+PathRegionGraph::CorridorStatus PathRegionGraph::findCorridor(uint32 baseIndex,
+    uint32 targetIndex, std::vector<uint32> &fenceNodes)
+{
+    uint32 baseRegion = regionOfNode(baseIndex);
+    uint32 targetRegion = regionOfNode(targetIndex);
+    if (baseRegion == kNoRegion || targetRegion == kNoRegion) {
+        return kCorridorNone;
+    }
+
+    const Route &route = findRoute(baseRegion, targetRegion);
+    if (route.empty()) {
+        return kCorridorUnreachable;
+    }
+
+    if (++currentStamp_ == 0) {
+        std::fill(regionStamps_.begin(), regionStamps_.end(), 0);
+        currentStamp_ = 1;
+    }
+
+    std::vector<uint32> corridor;
+    corridor.reserve(route.size() * 4);
+    for (Route::const_iterator it = route.begin(); it != route.end(); ++it) {
+        if (regionStamps_[*it] != currentStamp_) {
+            regionStamps_[*it] = currentStamp_;
+            corridor.push_back(*it);
+        }
+        const std::vector<uint32> &neighbours = regions_[*it].neighbours;
+        for (std::vector<uint32>::const_iterator nit = neighbours.begin();
+            nit != neighbours.end(); ++nit)
+        {
+            if (regionStamps_[*nit] != currentStamp_) {
+                regionStamps_[*nit] = currentStamp_;
+                corridor.push_back(*nit);
+            }
+        }
+    }
+
+    for (std::vector<uint32>::const_iterator it = corridor.begin(); it != corridor.end(); ++it) {
+        const std::vector<uint32> &portals = regions_[*it].portals;
+        for (std::vector<uint32>::const_iterator pit = portals.begin();
+            pit != portals.end(); ++pit)
+        {
+            if (regionStamps_[nodeRegions_[*pit]] != currentStamp_) {
+                fenceNodes.push_back(*pit);
+            }
+        }
+    }
+
+    return kCorridorFound;
+}
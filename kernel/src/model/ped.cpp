@@ -711,7 +711,7 @@ PedInstance::PedInstance(Ped *ped, uint16 anId, Map *pMap, bool isOur) :
     hostile_desc_(PedInstance::pd_smUndefined),
     obj_group_def_(PedInstance::og_dmUndefined),
     old_obj_group_def_(PedInstance::og_dmUndefined),
-    obj_group_id_(0), old_obj_group_id_(0),
+    obj_group_id_(0), group_index_(GroupSet::indexOf(0)), old_obj_group_id_(0),
     drawn_anim_(PedInstance::ad_StandAnim),
     sight_range_(0), in_vehicle_(NULL),
     owner_(NULL)
@@ -1268,10 +1268,12 @@ bool PedInstance::handleDeath(Mission *pMission, fs_dmg::DamageToInflict &d) {
 
 void PedInstance::addEnemyGroupDef(uint32 eg_id, uint32 eg_def) {
     enemy_group_defs_.add(eg_id, eg_def);
+    enemy_groups_.set(enemy_group_defs_);
 }
 
 void PedInstance::rmEnemyGroupDef(uint32 eg_id, uint32 eg_def) {
     enemy_group_defs_.rm(eg_id, eg_def);
+    enemy_groups_.set(enemy_group_defs_);
 }
 
 bool PedInstance::isInEnemyGroupDef(uint32 eg_id, uint32 eg_def) {
@@ -1280,9 +1282,11 @@ bool PedInstance::isInEnemyGroupDef(uint32 eg_id, uint32 eg_def) {
 
 void PedInstance::addEmulatedGroupDef(uint32 eg_id, uint32 eg_def) {
     emulated_group_defs_.add(eg_id, eg_def);
+    emulated_groups_.set(emulated_group_defs_);
 }
 void PedInstance::rmEmulatedGroupDef(uint32 eg_id, uint32 eg_def) {
     emulated_group_defs_.rm(eg_id, eg_def);
+    emulated_groups_.set(emulated_group_defs_);
 }
 
 bool PedInstance::isInEmulatedGroupDef(uint32 eg_id, uint32 eg_def) {
@@ -1298,6 +1302,27 @@ bool PedInstance::isInEmulatedGroupDef(PedInstance::Mmuu32_t &r_egd,
     return emulated_group_defs_.isIn_All(r_egd);
 }
 
+bool PedInstance::hasEnemyGroupOf(PedInstance *pPed) {
+    if (enemy_groups_.isExact()) {
+        return enemy_groups_.contains(pPed->group_index_, pPed->obj_group_def_);
+    }
+    return enemy_group_defs_.isIn(pPed->obj_group_id_, pPed->obj_group_def_);
+}
+
+bool PedInstance::emulatesGroupOf(PedInstance *pPed) {
+    if (emulated_groups_.isExact()) {
+        return emulated_groups_.contains(pPed->group_index_, pPed->obj_group_def_);
+    }
+    return emulated_group_defs_.isIn(pPed->obj_group_id_, pPed->obj_group_def_);
+}
+
+bool PedInstance::hasEnemyGroupEmulatedBy(PedInstance *pPed) {
+    if (enemy_groups_.isExact() && pPed->emulated_groups_.isExact()) {
+        return enemy_groups_.sharesGroupWith(pPed->emulated_groups_);
+    }
+    return pPed->emulated_group_defs_.isIn_KeyOnly(enemy_group_defs_);
+}
+
 /*!
  * Returns true if the given object is considered hostile by this Ped.
  * If object is a Vehicle, check if it contains hostiles inside.
@@ -1320,10 +1345,9 @@ bool PedInstance::isHostileTo(ShootableMapObject *obj,
         if (!isFriendWith(pPed)) {
             // Ped is not a declared friend, check its group
             if ((pPed)->emulatedGroupDefsEmpty()) {
-                isHostile =
-                    isInEnemyGroupDef(pPed->objGroupID(), pPed->objGroupDef());
+                isHostile = hasEnemyGroupOf(pPed);
             } else {
-                isHostile = pPed->isInEmulatedGroupDef(enemy_group_defs_);
+                isHostile = hasEnemyGroupEmulatedBy(pPed);
             }
             if (!isHostile) {
                 if (hostile_desc_alt == PedInstance::pd_smUndefined)
@@ -1346,7 +1370,7 @@ bool PedInstance::isFriendWith(PedInstance *p) {
     // Search ped in friends
     if (friends_found_.find(p) != friends_found_.end())
         return true;
-    if (p->isInEmulatedGroupDef(obj_group_id_, obj_group_def_)) {
+    if (p->emulatesGroupOf(this)) {
         if (obj_group_def_ == og_dmPolice
             && !isPersuaded())
         {
@@ -1619,6 +1643,7 @@ void PedInstance::handlePersuadedBy(PedInstance *pAgent) {
 
     /////////////////// Check if still useful ////////////
     pAgent->cpyEnemyDefs(enemy_group_defs_);
+    enemy_groups_.set(enemy_group_defs_);
     friends_found_.clear();
     hostiles_found_.clear();
     hostile_desc_ = pAgent->hostileDesc();
@@ -117,18 +117,28 @@ bool PedInstance::initMovementToDestination(Mission *m, const TilePoint &destina
         // path finding even if costly
         return false;
     }
-#ifdef EXECUTION_SPEED_TIME
-    printf("directions-map copy start %i.%i\n", SDL_GetTicks()/1000, SDL_GetTicks()%1000);
-#endif
+    // mdpoints_cp_ is a copy of mdpoints_ : nodes changed by the flood
+    // are restored once the path is created
     floodPointDesc *mdpmirror = m->mdpoints_cp_;
-    memcpy((void *)mdpmirror, (void *)m->mdpoints_,
-        m->mmax_x_ * m->mmax_y_ * m->mmax_z_ * sizeof(floodPointDesc));
 
-#ifdef EXECUTION_SPEED_TIME
-    printf("directions-map copy complete %i.%i\n", SDL_GetTicks()/1000, SDL_GetTicks()%1000);
-#endif
+    // the region graph limits the flood to the regions between base
+    // and target
+    PathRegionGraph::CorridorStatus corridor = m->closeFloodOutsideCorridor(
+        static_cast<uint32>(pos_.tx + pos_.ty * m->mmax_x_ + pos_.tz * m->mmax_m_xy),
+        static_cast<uint32>(clippedDestPt.tx + clippedDestPt.ty * m->mmax_x_ + clippedDestPt.tz * m->mmax_m_xy));
+    if (corridor == PathRegionGraph::kCorridorUnreachable) {
+        m->resetFloodWorkspace();
+        return false;
+    }
 
-    if (!floodMap(m, clippedDestPt, mdpmirror)) {
+    bool pathFound = floodMap(m, clippedDestPt, mdpmirror);
+    if (!pathFound && corridor == PathRegionGraph::kCorridorFound) {
+        // corridor was too narrow : try again on the whole map
+        m->resetFloodWorkspace();
+        pathFound = floodMap(m, clippedDestPt, mdpmirror);
+    }
+    if (!pathFound) {
+        m->resetFloodWorkspace();
         return false;
     }
 
@@ -141,6 +151,7 @@ bool PedInstance::initMovementToDestination(Mission *m, const TilePoint &destina
     cdestpath.reserve(256);
 
     createPath(m, mdpmirror, cdestpath);
+    m->resetFloodWorkspace();
 
 #ifdef EXECUTION_SPEED_TIME
     printf("path creation time %i.%i\n", SDL_GetTicks()/1000, SDL_GetTicks()%1000);
@@ -178,11 +189,10 @@ bool PedInstance::initMovementToDestination(Mission *m, const TilePoint &destina
 bool PedInstance::floodMap(Mission *m, const TilePoint &clippedDestPt, floodPointDesc *mdpmirror) {
     unsigned char lt;
     unsigned short blvl = 0, tlvl = 0;
-    // these are all tiles that belong to base and target
-    std::vector <toSetDesc> bv;
-    std::vector <toSetDesc> tv;
-    bv.reserve(8192);
-    tv.reserve(8192);
+    // these are all tiles that belong to base and target, they are kept
+    // by the mission so that modified nodes can be restored after search
+    std::vector <toSetDesc> &bv = m->flood_base_nodes_;
+    std::vector <toSetDesc> &tv = m->flood_target_nodes_;
     // these are used for setting values through algorithm
     toSetDesc sadd;
     floodPointDesc *pfdp;
@@ -0,0 +1,277 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+#include "fs-kernel/model/roadpathfinder.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+const uint16 RoadPathFinder::kDirNone = 0x0;
+const uint16 RoadPathFinder::kDirAll = 0xFFFF;
+
+namespace {
+    /*!
+     * Moves a car can do from a tile. The index of a move is also the
+     * index of the wrong direction for the next tile, and a move is
+     * forbidden when the wrong direction index is (move ^ 1).
+     */
+    struct RoadMove {
+        int dx;
+        int dy;
+        //! Mask on the road direction of the current tile
+        uint16 mask;
+        //! Value the masked direction must have
+        uint16 value;
+    };
+
+    const RoadMove kRoadMoves[4] = {
+        {-1, 0, 0xF000, 0x6000},
+        {1, 0, 0x00F0, 0x0020},
+        {0, -1, 0x0F00, 0x0400},
+        {0, 1, 0x000F, 0x0000}
+    };
+}
+
+RoadPathFinder::RoadPathFinder() {
+    layerZ_ = -1;
+    maxX_ = 0;
+    maxY_ = 0;
+    stamp_ = 0;
+}
+
+void RoadPathFinder::clear() {
+    layerZ_ = -1;
+    maxX_ = 0;
+    maxY_ = 0;
+    stamp_ = 0;
+    dirs_.clear();
+    walkable_.clear();
+    costs_.clear();
+    parents_.clear();
+    seenStamps_.clear();
+    closedStamps_.clear();
+    open_.clear();
+}
+
+/*!
+ * All tiles are set as non walkable : caller must then call setTile()
+ * for each tile of the layer.
+ * \param z Layer
+ * \param maxX width of the map
+ * \param maxY height of the map
+ */
+void RoadPathFinder::initLayer(int z, int maxX, int maxY) {
+    layerZ_ = z;
+    maxX_ = maxX;
+    maxY_ = maxY;
+    size_t nbTiles = static_cast<size_t>(maxX * maxY);
+    dirs_.assign(nbTiles, kDirNone);
+    walkable_.assign(nbTiles, 0);
+    costs_.assign(nbTiles * 4, 0);
+    parents_.assign(nbTiles * 4, -1);
+    seenStamps_.assign(nbTiles * 4, 0);
+    closedStamps_.assign(nbTiles * 4, 0);
+    open_.reserve(1024);
+    stamp_ = 0;
+}
+
+void RoadPathFinder::setTile(int x, int y, uint16 dir, bool walkable) {
+    size_t tile = static_cast<size_t>(x + y * maxX_);
+    dirs_[tile] = dir;
+    walkable_[tile] = walkable ? 1 : 0;
+}
+
+/*!
+ * Directions are coded on 4 groups of 4 bits, one per possible direction.
+ * A group set to 0xF means direction is not possible.
+ */
+bool RoadPathFinder::areDirsCompatible(uint16 dirStart, uint16 dirEnd) {
+    if (dirStart == kDirNone || dirEnd == kDirNone)
+        return false;
+    if (dirStart == kDirAll || dirEnd == kDirAll)
+        return true;
+
+    static const uint16 masks[4] = {0xF000, 0x0F00, 0x00F0, 0x000F};
+    for (int i = 0; i < 4; i++) {
+        if (((dirStart & masks[i]) != masks[i])
+            || ((dirEnd & masks[i]) != masks[i]))
+            if ((dirStart & masks[i]) == (dirEnd & masks[i]))
+                return true;
+    }
+
+    return false;
+}
+
+int RoadPathFinder::wrongDirIndex(uint16 wrongDir) {
+    switch (wrongDir) {
+    case 0x0020:
+        return 0;
+    case 0x6000:
+        return 1;
+    case 0x0000:
+        return 2;
+    default:
+        return 3;
+    }
+}
+
+bool RoadPathFinder::canDrive(size_t fromTile, size_t toTile) const {
+    return walkable_[toTile] != 0 && areDirsCompatible(dirs_[fromTile], dirs_[toTile]);
+}
+
+/*!
+ * \param startX Start tile
+ * \param startY Start tile
+ * \param startWrongDir Direction the car must not take from start tile
+ * \param targetX Destination tile
+ * \param targetY Destination tile
+ * \param maxExpansions Max number of nodes to explore before giving up
+ * \param pathX filled with X coords of the tiles from the tile after start
+ * to destination
+ * \param pathY filled with Y coords of the tiles
+ * \return status of the search
+ */
+RoadPathFinder::SearchStatus RoadPathFinder::findPath(int startX, int startY,
+    uint16 startWrongDir, int targetX, int targetY, int maxExpansions,
+    std::vector<int> &pathX, std::vector<int> &pathY)
+{
+    pathX.clear();
+    pathY.clear();
+
+    if (startX < 0 || startX >= maxX_ || startY < 0 || startY >= maxY_
+        || targetX < 0 || targetX >= maxX_ || targetY < 0 || targetY >= maxY_) {
+        return kSearchFailed;
+    }
+
+    if (++stamp_ == 0) {
+        std::fill(seenStamps_.begin(), seenStamps_.end(), 0);
+        std::fill(closedStamps_.begin(), closedStamps_.end(), 0);
+        stamp_ = 1;
+    }
+    open_.clear();
+
+    uint32 startNode = static_cast<uint32>((startX + startY * maxX_) * 4
+        + wrongDirIndex(startWrongDir));
+    costs_[startNode] = 0;
+    parents_[startNode] = -1;
+    seenStamps_[startNode] = stamp_;
+
+    OpenNode first;
+    first.g = 0;
+    first.f = static_cast<uint32>(abs(targetX - startX) + abs(targetY - startY));
+    first.node = startNode;
+    open_.push_back(first);
+
+    int32 goal = -1;
+    uint32 closest = startNode;
+    uint32 closestDist = first.f;
+    int expansions = 0;
+
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end());
+        OpenNode current = open_.back();
+        open_.pop_back();
+
+        if (closedStamps_[current.node] == stamp_ || current.g != costs_[current.node]) {
+            // node already closed or a shorter way was found since
+            continue;
+        }
+        closedStamps_[current.node] = stamp_;
+
+        size_t tile = current.node / 4;
+        int x = static_cast<int>(tile) % maxX_;
+        int y = static_cast<int>(tile) / maxX_;
+        uint32 dist = static_cast<uint32>(abs(targetX - x) + abs(targetY - y));
+        if (dist < closestDist) {
+            closestDist = dist;
+            closest = current.node;
+        }
+
+        if (x == targetX && y == targetY) {
+            goal = static_cast<int32>(current.node);
+            break;
+        }
+
+        if (++expansions > maxExpansions) {
+            break;
+        }
+
+        int wrongDir = static_cast<int>(current.node % 4);
+        uint16 goodDir = dirs_[tile];
+        for (int m = 0; m < 4; m++) {
+            if (wrongDir == (m ^ 1)) {
+                continue;
+            }
+            const RoadMove &move = kRoadMoves[m];
+            int nx = x + move.dx;
+            int ny = y + move.dy;
+            if (nx < 0 || nx >= maxX_ || ny < 0 || ny >= maxY_) {
+                continue;
+            }
+            if ((goodDir & move.mask) != move.value && goodDir != kDirAll) {
+                continue;
+            }
+            size_t nTile = static_cast<size_t>(nx + ny * maxX_);
+            if (!canDrive(tile, nTile)) {
+                continue;
+            }
+
+            uint32 nNode = static_cast<uint32>(nTile * 4 + static_cast<size_t>(m));
+            uint32 g = current.g + 1;
+            if (closedStamps_[nNode] == stamp_
+                || (seenStamps_[nNode] == stamp_ && costs_[nNode] <= g)) {
+                continue;
+            }
+            seenStamps_[nNode] = stamp_;
+            costs_[nNode] = g;
+            parents_[nNode] = static_cast<int32>(current.node);
+
+            OpenNode next;
+            next.g = g;
+            next.f = g + static_cast<uint32>(abs(targetX - nx) + abs(targetY - ny));
+            next.node = nNode;
+            open_.push_back(next);
+            std::push_heap(open_.begin(), open_.end());
+        }
+    }
+
+    SearchStatus status = kSearchReached;
+    if (goal == -1) {
+        if (open_.empty()) {
+            return kSearchFailed;
+        }
+        status = kSearchClosest;
+        goal = static_cast<int32>(closest);
+    }
+
+    for (uint32 n = static_cast<uint32>(goal); parents_[n] != -1;
+        n = static_cast<uint32>(parents_[n]))
+    {
+        int tile = static_cast<int>(n / 4);
+        pathX.push_back(tile % maxX_);
+        pathY.push_back(tile / maxX_);
+    }
+    std::reverse(pathX.begin(), pathX.end());
+    std::reverse(pathY.begin(), pathY.end());
+
+    return status;
+}
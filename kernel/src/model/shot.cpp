@@ -44,23 +44,28 @@ void InstantImpactShot::inflictDamage(Mission *pMission) {
     // so this map stores number of impacts for a target
     std::map<ShootableMapObject *, int> hitsByObject;
 
-    for (int i = 0; i < nbImpacts; ++i) {
-        WorldPoint impactPosW = dmg_.aimedLocW;
-
-        if (nbImpacts > 1) {
-            // When multiple impacts, they're spread
-            diffuseImpact(pMission, originLocW, &impactPosW);
-            /*if (impactPosW.z < originLocW.z) {
-                printf("Impact %d below Z\n", i);
-            }
-            printf("Impact %d apres diffuse %d %d %d\n", i, impactPosW.x, impactPosW.y, impactPosW.z);*/
+    std::vector<WorldPoint> impacts(static_cast<size_t>(nbImpacts), dmg_.aimedLocW);
+    // objects around the impacts are searched once for all impacts :
+    // nothing moves or is damaged until all impacts are known
+    std::vector<MapObject *> candidates;
+    const std::vector<MapObject *> *pCandidates = NULL;
+    if (nbImpacts > 1) {
+        // When multiple impacts, they're spread
+        for (size_t i = 0; i < impacts.size(); ++i) {
+            diffuseImpact(pMission, originLocW, &impacts[i]);
         }
+        pMission->findShotBlockerCandidates(originLocW, impacts, dmg_.d_owner, candidates);
+        pCandidates = &candidates;
+    }
+
+    for (size_t i = 0; i < impacts.size(); ++i) {
+        WorldPoint impactPosW = impacts[i];
 
         // Verify if shot hit something or was blocked by a tile
         ShootableMapObject *pTargetHit = NULL;
         pMission->checkIfBlockersInShootingLine(
-            originLocW, &pTargetHit, &impactPosW, true, false, dmg_.pWeapon->range(), NULL, dmg_.d_owner);
-        /*printf("Impact %d apres checkIfBlockers %d %d %d\n", i, impactPosW.x, impactPosW.y, impactPosW.z);*/
+            originLocW, &pTargetHit, &impactPosW, true, false, dmg_.pWeapon->range(), NULL,
+            dmg_.d_owner, pCandidates);
 
         if (pTargetHit != NULL) {
             hitsByObject[pTargetHit] = hitsByObject[pTargetHit] + 1;
@@ -114,7 +119,8 @@ void InstantImpactShot::diffuseImpact(Mission *pMission, const WorldPoint &origi
     double diff_ang = (angle * (double)(rand() % 100) / 200.0) * set_sign;
     angx += diff_ang;
     angle -= fabs(diff_ang);
-    int gtx = cx + (int)(cos(angx) * dist_cur);
+    double cosx = cos(angx);
+    int gtx = cx + (int)(cosx * dist_cur);
 
     set_sign = 1.0;
     if (rand() % 100 < 50)
@@ -122,43 +128,45 @@ void InstantImpactShot::diffuseImpact(Mission *pMission, const WorldPoint &origi
     diff_ang = (angle * (double)(rand() % 100) / 200.0) * set_sign;
     angy += diff_ang;
     angle -= fabs(diff_ang);
-    int gty = cy + (int)(cos(angy) * dist_cur);
+    double cosy = cos(angy);
+    int gty = cy + (int)(cosy * dist_cur);
 
     set_sign = 1.0;
     if (rand() % 100 < 50)
         set_sign = -1.0;
     angz += (angle * (double)(rand() % 100) / 200.0) * set_sign;
+    double cosz = cos(angz);
 
-    int gtz = cz + (int)(cos(angz) * dist_cur);
+    int gtz = cz + (int)(cosz * dist_cur);
 
     if (gtx < 0) {
-        if (cos(angx) == 0.0) {
+        if (cosx == 0.0) {
             gtx = 0;
         } else {
-            dist_cur -= fabs((double)gtx / cos(angx));
+            dist_cur -= fabs((double)gtx / cosx);
             gtx = 0;
-            gty = cy + (int)(cos(angy) * dist_cur);
-            gtz = cz + (int)(cos(angz) * dist_cur);
+            gty = cy + (int)(cosy * dist_cur);
+            gtz = cz + (int)(cosz * dist_cur);
         }
     }
     if (gty < 0) {
-        if (cos(angy) == 0.0) {
+        if (cosy == 0.0) {
             gty = 0;
         } else {
-            dist_cur -= fabs((double)gty / cos(angy));
+            dist_cur -= fabs((double)gty / cosy);
             gty = 0;
-            gtx = cx + (int)(cos(angx) * dist_cur);
-            gtz = cz + (int)(cos(angz) * dist_cur);
+            gtx = cx + (int)(cosx * dist_cur);
+            gtz = cz + (int)(cosz * dist_cur);
         }
     }
     if (gtz < 0) {
-        if (cos(angz) == 0.0) {
+        if (cosz == 0.0) {
             gtz = 0;
         } else {
-            dist_cur -= fabs((double)gtz / cos(angz));
+            dist_cur -= fabs((double)gtz / cosz);
             gtz = 0;
-            gtx = cx + (int)(cos(angx) * dist_cur);
-            gty = cy + (int)(cos(angy) * dist_cur);
+            gtx = cx + (int)(cosx * dist_cur);
+            gty = cy + (int)(cosy * dist_cur);
         }
     }
 
@@ -166,33 +174,33 @@ void InstantImpactShot::diffuseImpact(Mission *pMission, const WorldPoint &origi
     int max_y = (pMission->mmax_y_ - 1) * 256;
     int max_z = (pMission->mmax_z_ - 1) * 128;
     if (gtx > max_x) {
-        if (cos(angx) == 0.0) {
+        if (cosx == 0.0) {
             gtx = max_x;
         } else {
-            dist_cur -= fabs((double)(gtx - max_x) / cos(angx));
+            dist_cur -= fabs((double)(gtx - max_x) / cosx);
             gtx = max_x;
-            gty = cy + (int)(cos(angy) * dist_cur);
-            gtz = cz + (int)(cos(angz) * dist_cur);
+            gty = cy + (int)(cosy * dist_cur);
+            gtz = cz + (int)(cosz * dist_cur);
         }
     }
     if (gty > max_y) {
-        if (cos(angy) == 0.0) {
+        if (cosy == 0.0) {
             gty = max_y;
         } else {
-            dist_cur -= fabs((double)(gty - max_y) / cos(angy));
+            dist_cur -= fabs((double)(gty - max_y) / cosy);
             gty = max_y;
-            gtx = cx + (int)(cos(angx) * dist_cur);
-            gtz = cz + (int)(cos(angz) * dist_cur);
+            gtx = cx + (int)(cosx * dist_cur);
+            gtz = cz + (int)(cosz * dist_cur);
         }
     }
     if (gtz > max_z) {
-        if (cos(angx) == 0.0) {
+        if (cosx == 0.0) {
             gtz = max_z;
         } else {
-            dist_cur -= fabs((double)(gtz - max_z) / cos(angz));
+            dist_cur -= fabs((double)(gtz - max_z) / cosz);
             gtz = max_z;
-            gtx = cx + (int)(cos(angx) * dist_cur);
-            gty = cy + (int)(cos(angy) * dist_cur);
+            gtx = cx + (int)(cosx * dist_cur);
+            gty = cy + (int)(cosy * dist_cur);
         }
     }
     assert(gtx >= 0 && gty >= 0 && gtz >= 0);
@@ -359,46 +367,60 @@ void Explosion::generateFlameWaves(Mission *pMission, WorldPoint *pOrigin, doubl
 void Explosion::getAllShootablesWithinRange(Mission *pMission,
                                        const WorldPoint &originLocW,
                                        std::vector<ShootableMapObject *> &objInRangeVec) {
-    // Look at all peds alive, in range of explosion and not in a vehicle
-    for (size_t i = 0; i < pMission->numPeds(); ++i) {
-        PedInstance *p = pMission->ped(i);
-        if (p->isAlive() && p->isCloseTo(originLocW, dmg_.range) && p->inVehicle() == NULL) {
-            WorldPoint pedPosW(p->position());
-            if (pMission->checkBlockedByTile(originLocW, &pedPosW, false, dmg_.range) == 1) {
-                objInRangeVec.push_back(p);
-            }
+    std::vector<MapObject *> candidates;
+    pMission->getObjectGrid().findInRange(originLocW, static_cast<int32>(dmg_.range),
+        MapObject::kNaturePed | MapObject::kNatureStatic |
+        MapObject::kNatureVehicle | MapObject::kNatureWeapon, candidates);
+
+    // objects in range : lines of sight are checked all at once
+    std::vector<ShootableMapObject *> objectsInRange;
+    std::vector<VisibilityQuery> queries;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        ShootableMapObject *pObject = static_cast<ShootableMapObject *>(candidates[i]);
+        if (!pObject->isAlive()) {
+            continue;
         }
-    }
 
-    for (size_t i = 0; i < pMission->numStatics(); ++i) {
-        Static *st = pMission->statics(i);
-        if (!st->isExcludedFromBlockers() && st->isAlive() && st->isCloseTo(originLocW, dmg_.range)) {
-            WorldPoint staticPosW(st->position());
-            if (pMission->checkBlockedByTile(originLocW, &staticPosW, false, dmg_.range) == 1) {
-                objInRangeVec.push_back(st);
-            }
+        switch (pObject->nature()) {
+        case MapObject::kNaturePed:
+            // Look at all peds in range of explosion and not in a vehicle
+            if (!pObject->isCloseTo(originLocW, dmg_.range) ||
+                    static_cast<PedInstance *>(pObject)->inVehicle() != NULL)
+                continue;
+            break;
+        case MapObject::kNatureStatic:
+            if (static_cast<Static *>(pObject)->isExcludedFromBlockers() ||
+                    !pObject->isCloseTo(originLocW, dmg_.range))
+                continue;
+            break;
+        case MapObject::kNatureVehicle:
+            if (!pObject->isCloseTo(originLocW, dmg_.range))
+                continue;
+            break;
+        case MapObject::kNatureWeapon:
+        {
+            // look at all bombs on the ground except the weapon that generated the shot
+            WeaponInstance *w = static_cast<WeaponInstance *>(pObject);
+            if (!w->isInstanceOf(Weapon::TimeBomb) || w == dmg_.pWeapon || w->hasOwner())
+                continue;
+            break;
         }
-    }
-
-    // look at all vehicles
-    for (size_t i = 0; i < pMission->numVehicles(); ++i) {
-        ShootableMapObject *v = pMission->vehicle(i);
-        if (v->isAlive() && v->isCloseTo(originLocW, dmg_.range)) {
-            WorldPoint vehiclePosW(v->position());
-            if (pMission->checkBlockedByTile(originLocW, &vehiclePosW, false, dmg_.range) == 1) {
-                objInRangeVec.push_back(v);
-            }
+        default:
+            continue;
         }
+
+        VisibilityQuery query;
+        query.originPosW = originLocW;
+        query.targetPosW.convertFromTilePoint(pObject->position());
+        query.distanceMax = dmg_.range;
+        queries.push_back(query);
+        objectsInRange.push_back(pObject);
     }
 
-    // look at all bombs on the ground except the weapon that generated the shot
-    for (size_t i = 0; i < pMission->numWeaponsOnGround(); ++i) {
-        WeaponInstance *w = pMission->weaponOnGround(i);
-        if (w->isInstanceOf(Weapon::TimeBomb) && w != dmg_.pWeapon && !w->hasOwner() && w->isAlive()) {
-            WorldPoint weaponPosW(w->position());
-            if (pMission->checkBlockedByTile(originLocW, &weaponPosW, false, dmg_.range) == 1) {
-                objInRangeVec.push_back(w);
-            }
+    pMission->checkVisibility(queries);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        if (queries[i].result == 1) {
+            objInRangeVec.push_back(objectsInRange[i]);
         }
     }
 }
@@ -0,0 +1,72 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include "fs-kernel/model/simprofile.h"
+
+SimProfile::SimProfile() {
+    reset();
+}
+
+void SimProfile::reset() {
+    for (int i = 0; i < kSubCount; i++) {
+        totals_[i] = 0;
+    }
+    ticks_ = 0;
+}
+
+void SimProfile::end(Subsystem sub) {
+    std::chrono::steady_clock::duration d = std::chrono::steady_clock::now() - start_;
+    totals_[sub] += static_cast<uint64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+}
+
+uint64 SimProfile::total() const {
+    uint64 sum = 0;
+    for (int i = 0; i < kSubCount; i++) {
+        sum += totals_[i];
+    }
+    return sum;
+}
+
+const char *SimProfile::name(Subsystem sub) {
+    switch (sub) {
+    case kSubObjectives:
+        return "objectives";
+    case kSubSfx:
+        return "sfx";
+    case kSubThink:
+        return "think";
+    case kSubPeds:
+        return "peds";
+    case kSubVehicles:
+        return "vehicles";
+    case kSubWeapons:
+        return "weapons";
+    case kSubStatics:
+        return "statics";
+    case kSubShots:
+        return "shots";
+    default:
+        return "unknown";
+    }
+}
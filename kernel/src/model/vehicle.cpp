@@ -46,6 +46,8 @@ const uint8 Vehicle::kVehicleTypeSmallArmored = 0x1C;
 const uint8 Vehicle::kVehicleTypePolice = 0x24;
 const uint8 Vehicle::kVehicleTypeMedics = 0x28;
 
+const int GenericCar::kMaxRoadSearchExpansions = 65536;
+
 VehicleAnimation::VehicleAnimation() {
     vehicle_anim_ = kNormalAnim;
 }
@@ -341,31 +343,8 @@ bool GenericCar::dirWalkable(TilePoint *p, int x, int y, int z) {
     if(!(pMap_->isTileWalkableByCar(x,y,z)))
         return false;
 
-    uint16 dirStart = tileDir(p->tx,p->ty,p->tz);
-    uint16 dirEnd = tileDir(x,y,z);
-    if (dirStart == 0x0 || dirEnd == 0x0)
-        return false;
-    if (dirStart == 0xFFFF || dirEnd == 0xFFFF)
-        return true;
-
-    if (((dirStart & 0xF000) != 0xF000)
-        || ((dirEnd & 0xF000) != 0xF000))
-        if ((dirStart & 0xF000) == (dirEnd & 0xF000))
-                return true;
-    if (((dirStart & 0x0F00) != 0x0F00)
-        || ((dirEnd & 0x0F00) != 0x0F00))
-        if ((dirStart & 0x0F00) == (dirEnd & 0x0F00))
-                return true;
-    if (((dirStart & 0x00F0) != 0x00F0)
-        || ((dirEnd & 0x00F0) != 0x00F0))
-        if ((dirStart & 0x00F0) == (dirEnd & 0x00F0))
-                return true;
-    if (((dirStart & 0x000F) != 0x000F)
-        || ((dirEnd & 0x000F) != 0x000F))
-        if ((dirStart & 0x000F) == (dirEnd & 0x000F))
-                return true;
-
-    return false;
+    return RoadPathFinder::areDirsCompatible(tileDir(p->tx, p->ty, p->tz),
+        tileDir(x, y, z));
 }
 
 /*!
@@ -376,9 +355,6 @@ bool GenericCar::dirWalkable(TilePoint *p, int x, int y, int z) {
  * \return true if destination has been set correctly.
  */
 bool GenericCar::initMovementToDestination(Mission *pMission, const TilePoint &destinationPt, int newSpeed) {
-    std::map < TilePoint, uint16 > open;
-    std::set < TilePoint > closed;
-    std::map < TilePoint, TilePoint > parent;
     int basex = pos_.tx, basey = pos_.ty;
     std::vector < TilePoint > path2add;
     path2add.reserve(16);
@@ -416,9 +392,6 @@ bool GenericCar::initMovementToDestination(Mission *pMission, const TilePoint &d
         }
     }
 
-    TilePoint closest;
-    float closest_dist = 100000;
-
     uint16 wrong_dir = (uint16)getDirection(4);
     if (wrong_dir == 0x0)
         wrong_dir = 0x0400;
@@ -428,91 +401,42 @@ bool GenericCar::initMovementToDestination(Mission *pMission, const TilePoint &d
         wrong_dir = 0x0;
     else if(wrong_dir == 0x3)
         wrong_dir = 0x0020;
-    open.insert(std::pair< TilePoint, uint16 >(TilePoint(basex, basey, z, pos_.ox, pos_.oy),
-        wrong_dir));
-    int watchDog = 1000;
-
-    while (!open.empty()) {
-        watchDog--;
-        float dist = 100000;
-        TilePoint p;
-        std::map < TilePoint, uint16 >::iterator pit;
-        for (std::map < TilePoint, uint16 >::iterator it = open.begin();
-             it != open.end(); it++)
-        {
-            float d =
-                sqrt((float) (x - it->first.tx) * (x - it->first.tx) +
-                     (y - it->first.ty) * (y - it->first.ty));
-            if (d < dist) {
-                dist = d;
-                p = it->first;
-                pit = it;       // it cannot be const_iterator because of this assign
-                wrong_dir = it->second;
-            }
-        }
-        if (dist < closest_dist) {
-            closest = p;
-            closest_dist = dist;
-        }
-        //printf("found best dist %f in %i nodes\n", dist, open.size());
-        open.erase(pit);
-        closed.insert(p);
 
-        if ((p.tx == x && p.ty == y && p.tz == z)
-            || watchDog < 0)
-        {
-            if (watchDog < 0) {
-                p = closest;
-                dest_path_.
-                    push_front(TilePoint
-                               (p.tx, p.ty, p.tz, ox, oy));
-            } else
-                dest_path_.push_front(TilePoint(x, y, z, ox, oy));
-            while (parent.find(p) != parent.end()) {
-                p = parent[p];
-                if (p.tx == pos_.tx && p.ty == pos_.ty
-                    && p.tz == z)
-                    break;
-                dest_path_.push_front(p);
+    // Road directions of the layer are computed once per mission
+    RoadPathFinder &finder = pMission->getRoadPathFinder();
+    if (!finder.hasLayer(z)) {
+        finder.initLayer(z, pMap_->maxX(), pMap_->maxY());
+        for (int iy = 0; iy < pMap_->maxY(); iy++) {
+            for (int ix = 0; ix < pMap_->maxX(); ix++) {
+                finder.setTile(ix, iy, tileDir(ix, iy, z),
+                    pMap_->isTileWalkableByCar(ix, iy, z));
             }
-            break;
         }
+    }
 
-        std::map <TilePoint, uint16> neighbours;
-        uint16 goodDir = tileDir(p.tx, p.ty, p.tz);
+    std::vector<int> pathX;
+    std::vector<int> pathY;
+    RoadPathFinder::SearchStatus status = finder.findPath(basex, basey,
+        wrong_dir, x, y, kMaxRoadSearchExpansions, pathX, pathY);
 
-        if (wrong_dir != 0x6000 && p.tx > 0) {
-            if (dirWalkable(&p, p.tx - 1, p.ty, p.tz)
-                && ((goodDir & 0xF000) == 0x6000 || goodDir == 0xFFFF))
-                neighbours[TilePoint(p.tx - 1, p.ty, p.tz)] = 0x0020;
+    if (status != RoadPathFinder::kSearchFailed) {
+        if (basex != pos_.tx || basey != pos_.ty) {
+            dest_path_.push_back(TilePoint(basex, basey, z));
         }
-
-        if (wrong_dir != 0x0020 && p.tx < pMap_->maxX()) {
-            if (dirWalkable(&p, p.tx + 1, p.ty, p.tz)
-                && ((goodDir & 0x00F0) == 0x0020 || goodDir == 0xFFFF))
-                neighbours[TilePoint(p.tx + 1, p.ty, p.tz)] = 0x6000;
+        for (size_t i = 0; i < pathX.size(); i++) {
+            dest_path_.push_back(TilePoint(pathX[i], pathY[i], z));
         }
-
-        if (wrong_dir != 0x0400 && p.ty > 0)
-            if (dirWalkable(&p, p.tx, p.ty - 1, p.tz)
-                && ((goodDir & 0x0F00) == 0x0400 || goodDir == 0xFFFF))
-                neighbours[TilePoint(p.tx, p.ty - 1, p.tz)] = 0x0;
-
-        if (wrong_dir != 0x0000 && p.ty < pMap_->maxY())
-            if (dirWalkable(&p, p.tx, p.ty + 1, p.tz)
-                && ((goodDir & 0x000F) == 0x0 || goodDir == 0xFFFF))
-                neighbours[TilePoint(p.tx, p.ty + 1, p.tz)] = 0x0400;
-
-        for (std::map <TilePoint, uint16>::iterator it = neighbours.begin();
-            it != neighbours.end(); it++)
-            if (dirWalkable(&p, it->first.tx, it->first.ty,
-                it->first.tz)
-                && open.find(it->first) == open.end()
-                && closed.find(it->first) == closed.end())
-            {
-                parent[it->first] = p;
-                open.insert(*it);
+        if (status == RoadPathFinder::kSearchReached) {
+            if (dest_path_.empty()) {
+                dest_path_.push_back(TilePoint(x, y, z, ox, oy));
+            } else {
+                dest_path_.back().ox = ox;
+                dest_path_.back().oy = oy;
             }
+        } else if (!dest_path_.empty()) {
+            dest_path_.back().ox = ox;
+            dest_path_.back().oy = oy;
+        }
     }
 
     if(!dest_path_.empty()) {
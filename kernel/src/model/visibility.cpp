@@ -0,0 +1,82 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include "fs-kernel/model/visibility.h"
+
+VisibilityCache::LineKey::LineKey(const WorldPoint &originPosW,
+        const WorldPoint &targetPosW, double distMax) {
+    coords[0] = originPosW.x;
+    coords[1] = originPosW.y;
+    coords[2] = originPosW.z;
+    coords[3] = targetPosW.x;
+    coords[4] = targetPosW.y;
+    coords[5] = targetPosW.z;
+    distanceMax = distMax;
+}
+
+bool VisibilityCache::LineKey::operator<(const LineKey &other) const {
+    for (int i = 0; i < 6; i++) {
+        if (coords[i] != other.coords[i]) {
+            return coords[i] < other.coords[i];
+        }
+    }
+    return distanceMax < other.distanceMax;
+}
+
+VisibilityCache::VisibilityCache() {
+    hits_ = 0;
+    misses_ = 0;
+}
+
+/*!
+ * Statistics are kept.
+ */
+void VisibilityCache::clear() {
+    results_.clear();
+}
+
+/*!
+ * \param originPosW Start of the line
+ * \param targetPosW End of the line
+ * \param distanceMax Maximum length of the line
+ * \param pResult Set with the stored result if there is one
+ * \return true if a result was found
+ */
+bool VisibilityCache::find(const WorldPoint &originPosW, const WorldPoint &targetPosW,
+        double distanceMax, Result *pResult) {
+    std::map<LineKey, Result>::iterator it =
+        results_.find(LineKey(originPosW, targetPosW, distanceMax));
+    if (it == results_.end()) {
+        misses_++;
+        return false;
+    }
+
+    hits_++;
+    *pResult = it->second;
+    return true;
+}
+
+void VisibilityCache::store(const WorldPoint &originPosW, const WorldPoint &targetPosW,
+        double distanceMax, const Result &result) {
+    results_[LineKey(originPosW, targetPosW, distanceMax)] = result;
+}
@@ -0,0 +1,164 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "fs-utils/io/assetloader.h"
+#include "fs-utils/io/file.h"
+
+/*
+ * Checks that the AssetLoader frees the oldest prefetched file when too
+ * many files are waiting to be used, and that File::loadOriginalFile()
+ * returns the bytes of a prefetched file. The files are written in a
+ * temporary folder used as the original data folder.
+ */
+namespace {
+    std::string fileName(size_t i) {
+        return "prefetch" + std::to_string(i) + ".dat";
+    }
+
+    std::string content(size_t i) {
+        return "content of file " + std::to_string(i);
+    }
+
+    void writeFile(const fs::path &folder, const std::string &name, const std::string &text) {
+        FILE *fp = fopen((folder / name).string().c_str(), "wb");
+        if (fp) {
+            fwrite(text.data(), 1, text.size(), fp);
+            fclose(fp);
+        }
+    }
+
+    bool sameContent(const uint8 *data, size_t size, const std::string &text) {
+        return data != NULL && size == text.size() && memcmp(data, text.data(), size) == 0;
+    }
+
+    bool check(bool condition, const char *message) {
+        if (!condition) {
+            printf("FAILED : %s\n", message);
+        }
+        return condition;
+    }
+
+    /*!
+     * The loader has no worker so files are loaded in the calling thread.
+     */
+    bool checkEviction() {
+        AssetLoader loader(0);
+        bool ok = true;
+
+        for (size_t i = 0; i < AssetLoader::kMaxPrefetched; i++) {
+            loader.prefetch(fileName(i));
+        }
+        // first file becomes the most recent one
+        loader.prefetch(fileName(0));
+        // the loader is full : file 1 is now the oldest and is evicted
+        loader.prefetch(fileName(AssetLoader::kMaxPrefetched));
+
+        AssetLoader::Asset asset;
+        ok &= check(!loader.takePrefetched(fileName(1), asset), "oldest file is still prefetched");
+        ok &= check(loader.takePrefetched(fileName(0), asset), "file prefetched again has been evicted");
+        delete[] asset.data;
+        ok &= check(loader.takePrefetched(fileName(AssetLoader::kMaxPrefetched), asset),
+            "last file has not been prefetched");
+        delete[] asset.data;
+
+        // files can still be prefetched after many unused files
+        for (size_t i = 0; i < 4 * AssetLoader::kMaxPrefetched; i++) {
+            loader.prefetch(fileName(100 + i));
+        }
+        ok &= check(loader.takePrefetched(fileName(100 + 4 * AssetLoader::kMaxPrefetched - 1), asset),
+            "prefetch does nothing once the loader is full");
+        delete[] asset.data;
+
+        return ok;
+    }
+
+    /*!
+     * The file is changed on disk once prefetched : the old bytes must be
+     * returned, then the new ones when the file is loaded again.
+     */
+    bool checkPrefetchedContent(const fs::path &folder) {
+        AssetLoader loader(0);
+        bool ok = true;
+
+        writeFile(folder, "served.dat", "prefetched bytes");
+        File::prefetchOriginalFile("SERVED.DAT");
+        writeFile(folder, "served.dat", "bytes on disk");
+
+        size_t size = 0;
+        uint8 *data = File::loadOriginalFile("served.dat", size);
+        ok &= check(sameContent(data, size, "prefetched bytes"), "prefetched bytes are not returned");
+        delete[] data;
+
+        data = File::loadOriginalFile("served.dat", size);
+        ok &= check(sameContent(data, size, "bytes on disk"), "file is still prefetched once taken");
+        delete[] data;
+
+        return ok;
+    }
+
+    /*!
+     * Evicted files are freed by the workers while others are loading.
+     */
+    bool checkEvictionWithWorkers() {
+        AssetLoader loader(2);
+        bool ok = true;
+
+        for (size_t i = 0; i < 4 * AssetLoader::kMaxPrefetched; i++) {
+            loader.prefetch(fileName(100 + i));
+        }
+        for (size_t i = 3 * AssetLoader::kMaxPrefetched; i < 4 * AssetLoader::kMaxPrefetched; i++) {
+            size_t size = 0;
+            uint8 *data = File::loadOriginalFile(fileName(100 + i), size);
+            ok &= check(sameContent(data, size, content(100 + i)), "wrong content of a prefetched file");
+            delete[] data;
+        }
+
+        return ok;
+    }
+}
+
+int main() {
+    fs::path folder = fs::temp_directory_path() / "freesynd-assetloader-check";
+    fs::create_directories(folder);
+    for (size_t i = 0; i <= AssetLoader::kMaxPrefetched; i++) {
+        writeFile(folder, fileName(i), content(i));
+    }
+    for (size_t i = 0; i < 4 * AssetLoader::kMaxPrefetched; i++) {
+        writeFile(folder, fileName(100 + i), content(100 + i));
+    }
+    File::setOriginalDataFolder(folder.string());
+
+    bool ok = checkEviction();
+    ok &= checkPrefetchedContent(folder);
+    ok &= checkEvictionWithWorkers();
+
+    std::error_code error;
+    fs::remove_all(folder, error);
+
+    printf("%s\n", ok ? "AssetLoader OK" : "AssetLoader FAILED");
+    return ok ? 0 : 1;
+}
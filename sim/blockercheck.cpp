@@ -0,0 +1,274 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include <random>
+#include <vector>
+
+#include <math.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "fs-utils/common.h"
+#include "fs-engine/gfx/tile.h"
+#include "fs-engine/gfx/tilemanager.h"
+#include "fs-kernel/model/leveldata.h"
+#include "fs-kernel/model/map.h"
+#include "fs-kernel/model/mission.h"
+#include "fs-kernel/model/static.h"
+
+/*
+ * Checks that Mission::checkBlockedByObject() finds the same blocker and
+ * the same clipped segment as a test of every object with
+ * MapObject::isBlocker(), on random objects and random rays. The mission
+ * only searches the objects given by its grid, so this also checks that
+ * the grid returns all the objects that can be on a line. Each ray is
+ * also searched in the candidates that findShotBlockerCandidates() gives
+ * for a shot with several impacts.
+ */
+namespace {
+    //! Side of the map in tiles
+    const int kMapTiles = 12;
+    //! Height of the map in tiles
+    const int kMapHeight = 4;
+
+    //! Gives empty tiles without reading the original data
+    class EmptyTileManager : public TileManager {
+    public:
+        EmptyTileManager() {
+            uint8 pixels[TILE_WIDTH * TILE_HEIGHT];
+            memset(pixels, 255, sizeof(pixels));
+            for (int i = 0; i < kNumOfTiles; i++) {
+                a_tiles_[i] = new Tile(static_cast<uint8>(i), pixels, false, Tile::kNone);
+            }
+        }
+    };
+
+    //! A segment and the result of the search of a blocker
+    struct Ray {
+        WorldPoint start;
+        WorldPoint end;
+        double dist;
+        MapObject *pBlocker;
+    };
+
+    void writeLeUint32(uint8 *data, uint32 num) {
+        WRITE_LE_UINT16(data, static_cast<uint16>(num & 0xFFFF));
+        WRITE_LE_UINT16(data + 2, static_cast<uint16>(num >> 16));
+    }
+
+    /*!
+     * Returns map data in the format read by Map::loadMap() : all columns
+     * share the same empty column.
+     */
+    std::vector<uint8> emptyMapData() {
+        std::vector<uint8> data(12 + kMapTiles * kMapTiles * 4 + kMapHeight, 0);
+        writeLeUint32(&data[0], kMapTiles);
+        writeLeUint32(&data[4], kMapTiles);
+        writeLeUint32(&data[8], kMapHeight);
+        for (int i = 0; i < kMapTiles * kMapTiles; i++) {
+            writeLeUint32(&data[static_cast<size_t>(12 + i * 4)], kMapTiles * kMapTiles * 4);
+        }
+        return data;
+    }
+
+    WorldPoint randomPoint(std::mt19937 &rng) {
+        std::uniform_int_distribution<int> xy(0, kMapTiles * 256 - 1);
+        std::uniform_int_distribution<int> z(0, (kMapHeight - 1) * 128 - 1);
+        WorldPoint pt;
+        pt.x = xy(rng);
+        pt.y = xy(rng);
+        pt.z = z(rng);
+        return pt;
+    }
+
+    void initRay(Ray &ray, const WorldPoint &start, const WorldPoint &end) {
+        ray.start = start;
+        ray.end = end;
+        int dx = end.x - start.x;
+        int dy = end.y - start.y;
+        int dz = end.z - start.z;
+        ray.dist = sqrt((double)(dx * dx + dy * dy + dz * dz));
+        ray.pBlocker = NULL;
+    }
+
+    bool samePoint(const WorldPoint &a, const WorldPoint &b) {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    /*!
+     * Tests every static of the mission that can block a shot and keeps
+     * the closest one, like checkBlockedByObject() did before the grid.
+     */
+    void findNearest(Mission &mission, Ray &ray) {
+        double inc_xyz[3];
+        inc_xyz[0] = (ray.end.x - ray.start.x) / ray.dist;
+        inc_xyz[1] = (ray.end.y - ray.start.y) / ray.dist;
+        inc_xyz[2] = (ray.end.z - ray.start.z) / ray.dist;
+        WorldPoint copyStartPt = ray.start;
+        WorldPoint copyEndPt = ray.end;
+        WorldPoint blockStartPt;
+        WorldPoint blockEndPt;
+        double closest = ray.dist;
+
+        for (size_t i = 0; i < mission.numStatics(); i++) {
+            Static *pStatic = mission.statics(i);
+            if (pStatic->isExcludedFromBlockers()) {
+                continue;
+            }
+            if (pStatic->isBlocker(&copyStartPt, &copyEndPt, inc_xyz)) {
+                int cx = ray.start.x - copyStartPt.x;
+                int cy = ray.start.y - copyStartPt.y;
+                int cz = ray.start.z - copyStartPt.z;
+                double dist_blocker = sqrt((double) (cx * cx + cy * cy + cz * cz));
+                if (closest == -1 || dist_blocker < closest) {
+                    closest = dist_blocker;
+                    ray.pBlocker = pStatic;
+                    blockStartPt = copyStartPt;
+                    blockEndPt = copyEndPt;
+                }
+                copyStartPt = ray.start;
+                copyEndPt = ray.end;
+            }
+        }
+        if (ray.pBlocker != NULL) {
+            ray.start = blockStartPt;
+            ray.end = blockEndPt;
+            ray.dist = closest;
+        }
+    }
+
+    /*!
+     * Returns true if both searches found the same blocker. When objects
+     * overlap, several of them can be hit at the same distance and the
+     * first one tested is kept : the order of the objects given by the
+     * grid is not the order of the mission, so any of them is accepted.
+     */
+    bool sameResult(const Ray &ref, const Ray &ray) {
+        if (ref.pBlocker != ray.pBlocker) {
+            return ref.pBlocker && ray.pBlocker && ref.dist == ray.dist;
+        }
+        return ref.dist == ray.dist && samePoint(ref.start, ray.start)
+            && samePoint(ref.end, ray.end);
+    }
+}
+
+/*!
+ * Places random statics on an empty map and compares the blockers found
+ * for random rays. Returns a non zero value if a result is different.
+ */
+int main(int argc, char *argv[]) {
+    unsigned int seed = argc > 1 ? static_cast<unsigned int>(atoi(argv[1])) : 1;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> sizeXY(4, 256);
+    // bigger than the margin of the grid cells
+    std::uniform_int_distribution<int> bigSizeXY(256, 640);
+    std::uniform_int_distribution<int> sizeZ(8, 128);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    EmptyTileManager tileManager;
+    Map map(&tileManager, 0);
+    std::vector<uint8> mapData = emptyMapData();
+    map.loadMap(&mapData[0]);
+
+    LevelData::MapInfos infos;
+    memset(&infos, 0, sizeof(infos));
+    WRITE_LE_UINT16(infos.max_x, kMapTiles * 2);
+    WRITE_LE_UINT16(infos.max_y, kMapTiles * 2);
+
+    int nbDiff = 0;
+    int nbRays = 0;
+    int nbBlocked = 0;
+    std::vector<MapObject *> candidates;
+    const int nbObjects[] = { 1, 8, 32, 128 };
+    for (int nb : nbObjects) {
+        Mission mission(infos, &map);
+        std::vector<Static *> statics;
+        for (int i = 0; i < nb; i++) {
+            Static *pStatic = new EtcObj(static_cast<uint16>(i), &map, 0, 0, 0);
+            pStatic->setPosition(randomPoint(rng));
+            bool big = percent(rng) < 10;
+            pStatic->setSizeX(big ? bigSizeXY(rng) : sizeXY(rng));
+            pStatic->setSizeY(big ? bigSizeXY(rng) : sizeXY(rng));
+            pStatic->setSizeZ(sizeZ(rng));
+            pStatic->setExcludedFromBlockers(percent(rng) < 10);
+            mission.addStatic(pStatic);
+            statics.push_back(pStatic);
+        }
+
+        for (int i = 0; i < 20000; i++) {
+            WorldPoint start = randomPoint(rng);
+            WorldPoint end = randomPoint(rng);
+            if (i % 2 == 0) {
+                // a shot at an object
+                end = WorldPoint(statics[static_cast<size_t>(i / 2) % statics.size()]->position());
+            } else if (i % 4 == 1) {
+                // straight rays : some increments are 0
+                end.y = start.y;
+                end.z = start.z;
+            }
+            if (samePoint(start, end)) {
+                end.x = start.x + 1;
+            }
+
+            Ray ref;
+            initRay(ref, start, end);
+            Ray ray = ref;
+            findNearest(mission, ref);
+            ray.pBlocker = mission.checkBlockedByObject(&ray.start, &ray.end, &ray.dist, NULL);
+
+            // the candidates of a shot with several impacts are searched
+            // once for all lines : this ray is one of them
+            std::vector<WorldPoint> impacts;
+            impacts.push_back(randomPoint(rng));
+            impacts.push_back(end);
+            impacts.push_back(randomPoint(rng));
+            candidates.clear();
+            mission.findShotBlockerCandidates(start, impacts, NULL, candidates);
+            Ray shotRay;
+            initRay(shotRay, start, end);
+            shotRay.pBlocker = mission.checkBlockedByObject(&shotRay.start, &shotRay.end,
+                &shotRay.dist, NULL, &candidates);
+
+            nbRays++;
+            if (ref.pBlocker) {
+                nbBlocked++;
+            }
+            if (!sameResult(ref, ray) || !sameResult(ref, shotRay)) {
+                if (nbDiff < 10) {
+                    printf("ray %d with %d objects : blocker %d (%d with candidates) instead of %d\n",
+                        i, nb, ray.pBlocker ? ray.pBlocker->id() : -1,
+                        shotRay.pBlocker ? shotRay.pBlocker->id() : -1,
+                        ref.pBlocker ? ref.pBlocker->id() : -1);
+                }
+                nbDiff++;
+            }
+        }
+    }
+
+    printf("%d rays, %d rays blocked\n", nbRays, nbBlocked);
+    if (nbDiff) {
+        printf("%d results differ from the test of every object\n", nbDiff);
+    }
+    return nbDiff == 0 ? 0 : 1;
+}
@@ -0,0 +1,266 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include <memory>
+#include <string>
+#include <chrono>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "fs-utils/common.h"
+#include "fs-utils/log/log.h"
+#include "fs-utils/io/file.h"
+#include "fs-engine/appcontext.h"
+#include "fs-engine/gfx/spritemanager.h"
+#include "fs-engine/sound/soundmanager.h"
+#include "fs-kernel/mgr/mapmanager.h"
+#include "fs-kernel/mgr/modmanager.h"
+#include "fs-kernel/mgr/weaponmanager.h"
+#include "fs-kernel/mgr/agentmanager.h"
+#include "fs-kernel/mgr/missionmanager.h"
+#include "fs-kernel/model/mission.h"
+#include "fs-kernel/model/simprofile.h"
+#include "fs-kernel/ia/actions.h"
+
+#include "squadcontroller.h"
+
+namespace {
+    //! Duration of a simulation step, same as in the game
+    const int kSimulationStep = 33;
+
+    //! Parameters of the simulation read on the command line
+    struct SimParam {
+        std::string iniPath;
+        std::string userConfPath;
+        std::string logMask;
+        std::string scriptPath;
+        int missionId = 1;
+        int maxTicks = 9000;
+        unsigned int seed = 1;
+        //! Number of think workers, -1 to keep the default
+        int nbWorkers = -1;
+    };
+
+    void printUsage() {
+        printf("usage: freesynd-sim [options...]\n");
+        printf("    -h, --help            display this help and exit.\n");
+        printf("    -i, --ini <path>      specify the location of the FreeSynd config file.\n");
+        printf("    -u, --user <path>     specify the location of the user.conf file.\n");
+        printf("    -m, --mission <num>   id of the mission to simulate (default: 1).\n");
+        printf("    -t, --ticks <num>     max number of simulation steps (default: 9000).\n");
+        printf("    -s, --seed <num>      seed for the random generator (default: 1).\n");
+        printf("    -w, --workers <num>   threads added for the think phase of peds (0: none).\n");
+        printf("    --script <path>       play the squad orders from the file instead of random orders.\n");
+#ifdef _DEBUG
+        printf("    -l, --log <flags>     apply the specified log flags separated by colon.\n");
+#endif
+    }
+
+    /*!
+     * \return 0 if simulation can run, 1 if the program must stop
+     * and 2 for an invalid parameter
+     */
+    int parseCommandLine(int argc, char *argv[], SimParam *pParam) {
+        for (int i = 1; i < argc; ++i) {
+            bool hasValue = i + 1 < argc;
+            if (0 == strcmp("-h", argv[i]) || 0 == strcmp("--help", argv[i])) {
+                printUsage();
+                return 1;
+            } else if (hasValue && (0 == strcmp("-i", argv[i]) || 0 == strcmp("--ini", argv[i]))) {
+                pParam->iniPath = argv[++i];
+            } else if (hasValue && (0 == strcmp("-u", argv[i]) || 0 == strcmp("--user", argv[i]))) {
+                pParam->userConfPath = argv[++i];
+            } else if (hasValue && (0 == strcmp("-m", argv[i]) || 0 == strcmp("--mission", argv[i]))) {
+                pParam->missionId = atoi(argv[++i]);
+            } else if (hasValue && (0 == strcmp("-t", argv[i]) || 0 == strcmp("--ticks", argv[i]))) {
+                pParam->maxTicks = atoi(argv[++i]);
+            } else if (hasValue && (0 == strcmp("-s", argv[i]) || 0 == strcmp("--seed", argv[i]))) {
+                pParam->seed = static_cast<unsigned int>(strtoul(argv[++i], NULL, 10));
+            } else if (hasValue && (0 == strcmp("-w", argv[i]) || 0 == strcmp("--workers", argv[i]))) {
+                pParam->nbWorkers = atoi(argv[++i]);
+            } else if (hasValue && 0 == strcmp("--script", argv[i])) {
+                pParam->scriptPath = argv[++i];
+            } else if (hasValue && (0 == strcmp("-l", argv[i]) || 0 == strcmp("--log", argv[i]))) {
+                pParam->logMask = argv[++i];
+            } else {
+                printf("Unknown or incomplete option : %s\n", argv[i]);
+                printUsage();
+                return 2;
+            }
+        }
+
+        if (pParam->missionId < 1 || pParam->missionId > 50 || pParam->maxTicks <= 0) {
+            printUsage();
+            return 2;
+        }
+
+        return 0;
+    }
+
+    const char *statusName(Mission::Status status) {
+        switch (status) {
+        case Mission::kMissionStatusAborted:
+            return "aborted";
+        case Mission::kMissionStatusFailed:
+            return "failed";
+        case Mission::kMissionStatusCompleted:
+            return "completed";
+        default:
+            return "running";
+        }
+    }
+
+    void printReport(int missionId, Mission *pMission, const SimProfile &profile, double seconds) {
+        uint32 ticks = profile.ticks();
+        printf("Mission %d : %u steps (%.1f s of game) simulated in %.3f s, mission is %s\n",
+            missionId, ticks, ticks * kSimulationStep / 1000.0, seconds,
+            statusName(pMission->getStatus()));
+        if (seconds > 0.0) {
+            printf("%.1f ticks/s (x%.1f real time)\n", ticks / seconds,
+                ticks * kSimulationStep / 1000.0 / seconds);
+        }
+
+        uint64 total = profile.total();
+        printf("%-12s %12s %14s %8s\n", "subsystem", "total (ms)", "per tick (us)", "share");
+        for (int i = 0; i < SimProfile::kSubCount; i++) {
+            SimProfile::Subsystem sub = static_cast<SimProfile::Subsystem>(i);
+            double ns = static_cast<double>(profile.total(sub));
+            printf("%-12s %12.3f %14.3f %7.1f%%\n", SimProfile::name(sub),
+                ns / 1000000.0, ticks ? ns / 1000.0 / ticks : 0.0,
+                total ? ns * 100.0 / static_cast<double>(total) : 0.0);
+        }
+
+        UnpackedFileCache::Stats unpacked = File::unpackedCacheStats();
+        printf("unpacked files : %llu hits, %llu disk hits, %llu misses, %llu bytes served, %llu bytes unpacked\n",
+            unpacked.hits, unpacked.diskHits, unpacked.misses,
+            unpacked.bytesServed, unpacked.bytesUnpacked);
+
+        ActionPool::Stats actions = Action::pool().stats();
+        printf("actions : %llu allocated (%.2f per tick), %llu reused, %llu heap allocations (%.3f per tick), %llu bytes reserved\n",
+            actions.allocations, ticks ? static_cast<double>(actions.allocations) / ticks : 0.0,
+            actions.reuses, actions.heapAllocations,
+            ticks ? static_cast<double>(actions.heapAllocations) / ticks : 0.0,
+            static_cast<uint64>(actions.bytesReserved));
+    }
+}
+
+/*!
+ * Runs a mission without display nor sound to measure the time spent
+ * in the simulation.
+ */
+int main(int argc, char *argv[]) {
+    SimParam param;
+    int res = parseCommandLine(argc, argv, &param);
+    if (res != 0) {
+        return res == 1 ? 0 : 1;
+    }
+
+    Log::initialize(param.logMask, "sim.log");
+    srand(param.seed);
+
+    AppContext context;
+    if (!context.readConfiguration(param.iniPath, param.userConfPath)) {
+        Log::close();
+        return 1;
+    }
+
+    // Sprites are needed for the length of animations
+    GameSpriteManager sprites;
+    sprites.load();
+    SoundManager sounds;
+    sounds.initialize(NULL, true, false);
+
+    MapManager maps;
+    if (!maps.initialize()) {
+        Log::close();
+        return 1;
+    }
+
+    ModManager mods;
+    WeaponManager weapons;
+    AgentManager agents;
+    agents.setModManager(&mods);
+    agents.setWeaponManager(&weapons);
+    mods.reset();
+    weapons.reset();
+    agents.reset();
+
+    MissionManager missions(&maps);
+    Mission *pMission = missions.loadMission(param.missionId);
+    if (pMission == NULL) {
+        printf("Cannot load mission %d\n", param.missionId);
+        agents.destroy();
+        Log::close();
+        return 1;
+    }
+
+    std::unique_ptr<SquadController> controller;
+    if (param.scriptPath.empty()) {
+        controller = std::make_unique<RandomSquadController>();
+    } else {
+        std::unique_ptr<ScriptedSquadController> script = std::make_unique<ScriptedSquadController>();
+        if (!script->load(param.scriptPath)) {
+            missions.destroyMission();
+            agents.destroy();
+            Log::close();
+            return 1;
+        }
+        controller = std::move(script);
+    }
+
+    pMission->start(weapons);
+    if (param.nbWorkers >= 0) {
+        pMission->setThinkWorkers(static_cast<size_t>(param.nbWorkers));
+    }
+
+    SimProfile profile;
+    int missionTime = 0;
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < param.maxTicks; tick++) {
+        controller->update(pMission, missionTime);
+
+        profile.begin();
+        pMission->stats()->incrMissionDuration(kSimulationStep);
+        pMission->checkObjectives();
+        profile.end(SimProfile::kSubObjectives);
+
+        pMission->animate(kSimulationStep, &profile);
+        profile.incrTicks();
+        missionTime += kSimulationStep;
+
+        if (pMission->completed() || pMission->failed()) {
+            break;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    printReport(param.missionId, pMission, profile, elapsed.count());
+
+    missions.destroyMission();
+    agents.destroy();
+    Log::close();
+
+    return 0;
+}
@@ -0,0 +1,691 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "fs-utils/common.h"
+#include "fs-utils/crc/dernc.h"
+
+namespace fs = std::filesystem;
+
+/*
+ * Reference decoder : this is the implementation of rnc::unpack() that
+ * decodes Huffman codes by scanning the table, reads the input
+ * 16 bits at a time and computes the CRC byte per byte. It is kept here to measure the speed of the
+ * current decoder against it and to check that both give the same data.
+ */
+namespace reference {
+    struct BitStream {
+        uint32 bit_buffer;      // Holds between 16 and 32 bits
+        int bit_count;          // How many bits does bitbuf hold?
+    };
+
+    struct HuffmanTable {
+        int node_count;         // Number of nodes in the tree
+        struct {
+            uint32 code;
+            int code_length;
+            int value;
+        } table[32];
+    };
+
+    uint32 bitPeek(BitStream &bit_stream, uint32 mask) {
+        return bit_stream.bit_buffer & mask;
+    }
+
+    void bitAdvance(BitStream &bit_stream, int count, uint8 *&packed_data) {
+        bit_stream.bit_buffer >>= count;
+        bit_stream.bit_count -= count;
+        if (bit_stream.bit_count < 16) {
+            packed_data += 2;
+            bit_stream.bit_buffer |=
+                static_cast<uint32>(READ_LE_UINT16(packed_data) << bit_stream.bit_count);
+            bit_stream.bit_count += 16;
+        }
+    }
+
+    void bitAdvance8(BitStream &bit_stream, int count,
+            uint8 *&packed_data, uint8 *packed_data_end) {
+        bit_stream.bit_buffer >>= count;
+        bit_stream.bit_count -= count;
+        if (bit_stream.bit_count < 16) {
+            packed_data += 2;
+            if (packed_data < packed_data_end) {
+                bit_stream.bit_buffer |=
+                    ((uint32)(*packed_data) << bit_stream.bit_count);
+                bit_stream.bit_count += 16;
+            }
+        }
+    }
+
+    uint32 bitRead(BitStream &bit_stream, uint32 mask, int count,
+            uint8 *&packed_data) {
+        uint32 result = bitPeek(bit_stream, mask);
+        bitAdvance(bit_stream, count, packed_data);
+        return result;
+    }
+
+    uint32 bitRead8(BitStream &bit_stream, uint32 mask, int count,
+            uint8 *&packed_data, uint8 *packed_data_end) {
+        uint32 result = bitPeek(bit_stream, mask);
+        bitAdvance8(bit_stream, count, packed_data, packed_data_end);
+        return result;
+    }
+
+    void readHuffmanTable(HuffmanTable &huffman_table,
+            BitStream &bit_stream, uint8 *&packed_data) {
+        int count = static_cast<int>(bitRead(bit_stream, 0x1f, 5, packed_data));
+        if (!count)
+            return;
+
+        int leaf_max = 1;
+        int leaf_length[32];
+        for (int i = 0; i < count; ++i) {
+            leaf_length[i] = static_cast<int>(bitRead(bit_stream, 0x0f, 4, packed_data));
+            if (leaf_max < leaf_length[i])
+                leaf_max = leaf_length[i];
+        }
+
+        uint32 code_b = 0;
+        int node_count = 0;
+        for (int i = 1; i <= leaf_max; ++i) {
+            for (int j = 0; j < count; ++j)
+                if (leaf_length[j] == i) {
+                    huffman_table.table[node_count].code =
+                        mirror(code_b, i);
+                    huffman_table.table[node_count].code_length = i;
+                    huffman_table.table[node_count].value = j;
+                    ++code_b;
+                    ++node_count;
+                }
+            code_b <<= 1;
+        }
+
+        huffman_table.node_count = node_count;
+    }
+
+    int readHuffmanData(HuffmanTable &huffman_table,
+            BitStream &bit_stream, uint8 *&packed_data,
+            uint8 *packed_data_end) {
+        int i;
+        uint32 mask;
+
+        for (i = 0; i < huffman_table.node_count; ++i) {
+            mask = static_cast<uint32>((1 << huffman_table.table[i].code_length) - 1);
+            if (bitPeek(bit_stream, mask) == huffman_table.table[i].code)
+                break;
+        }
+
+        if (i == huffman_table.node_count)
+            return -1;
+        if ((packed_data + 2) < packed_data_end)
+            bitAdvance(bit_stream, huffman_table.table[i].code_length,
+                   packed_data);
+        else
+            bitAdvance8(bit_stream, huffman_table.table[i].code_length,
+                   packed_data, packed_data_end);
+
+        uint32 result = static_cast<uint32>(huffman_table.table[i].value);
+
+        if (result >= 2) {
+            result = 1 << (result - 1);
+            if ((packed_data + 2) < packed_data_end)
+                result |= bitRead(bit_stream, result - 1,
+                        huffman_table.table[i].value - 1, packed_data);
+            else
+                result |= bitRead8(bit_stream, result - 1,
+                        huffman_table.table[i].value - 1, packed_data,
+                        packed_data_end);
+        }
+
+        return static_cast<int>(result);
+    }
+
+    void bitReadFix(BitStream &bit_stream, uint8 *&packed_data) {
+        bit_stream.bit_count -= 16;
+        bit_stream.bit_buffer &= static_cast<uint32>((1 << bit_stream.bit_count) - 1);
+        bit_stream.bit_buffer |=
+            static_cast<uint32>(READ_LE_UINT16(packed_data) << bit_stream.bit_count);
+        bit_stream.bit_count += 16;
+    }
+
+    void bitReadFix8(BitStream &bit_stream, uint8 *&packed_data) {
+        bit_stream.bit_count -= 16;
+        bit_stream.bit_buffer &= static_cast<uint32>((1 << bit_stream.bit_count) - 1);
+        bit_stream.bit_buffer |=
+            ((uint32)(*packed_data) << bit_stream.bit_count);
+        bit_stream.bit_count += 16;
+    }
+
+    uint16 crc(uint8 *data, int data_length) {
+        static uint16 crc_table[256];
+        static bool initialized = false;
+        if (!initialized) {
+            for (int i = 0; i < 256; ++i) {
+                uint16 temp = static_cast<uint16>(i);
+                for (int j = 0; j < 8; ++j)
+                    temp = (temp & 1 ? (temp >> 1) ^ 0xA001 : temp >> 1);
+                crc_table[i] = temp;
+            }
+            initialized = true;
+        }
+
+        uint16 result = 0;
+        do {
+            result ^= *data++;
+            result = (result >> 8) ^ crc_table[result & 0xff];
+        } while (--data_length);
+
+        return result;
+    }
+
+    int unpack(uint8 *packed_data, uint8 *unpacked_data) {
+        if (READ_BE_UINT32(packed_data) != RNC_SIGNATURE)
+            return rnc::FILE_IS_NOT_RNC;
+
+        int output_length = static_cast<int>(READ_BE_UINT32(packed_data + 4));
+        int input_length = static_cast<int>(READ_BE_UINT32(packed_data + 8));
+
+        uint16 unpacked_crc = READ_BE_UINT16(packed_data + 12);
+        uint16 packed_crc = READ_BE_UINT16(packed_data + 14);
+
+        uint8 *input = packed_data + 18;
+        uint8 *output = unpacked_data;
+
+        uint8 *input_end = input + input_length;
+        uint8 *output_end = output + output_length;
+
+        if (crc(input, input_length) != packed_crc)
+            return rnc::PACKED_CRC_ERROR;
+
+        BitStream bit_stream;
+        bit_stream.bit_buffer = READ_LE_UINT16(input);
+        bit_stream.bit_count = 16;
+        bitAdvance(bit_stream, 2, input);
+
+        HuffmanTable raw_huff_tbl, dist_huff_tbl, len_huff_tbl;
+        int length, position;
+        uint32 ch_count;
+        while (output < output_end) {
+            readHuffmanTable(raw_huff_tbl, bit_stream, input);
+            readHuffmanTable(dist_huff_tbl, bit_stream, input);
+            readHuffmanTable(len_huff_tbl, bit_stream, input);
+
+            ch_count = bitRead(bit_stream, 0xffff, 16, input);
+
+            while (1) {
+                length = readHuffmanData(raw_huff_tbl, bit_stream, input,
+                    input_end);
+                if (length == -1)
+                    return rnc::HUF_DECODE_ERROR;
+
+                if (length) {
+                    while (length--)
+                        *output++ = *input++;
+                    if ((input + 1) < input_end)
+                        bitReadFix(bit_stream, input);
+                    else
+                        bitReadFix8(bit_stream, input);
+                }
+
+                if (--ch_count <= 0)
+                    break;
+
+                position = readHuffmanData(dist_huff_tbl, bit_stream, input,
+                    input_end);
+                if (position == -1)
+                    return rnc::HUF_DECODE_ERROR;
+
+                length = readHuffmanData(len_huff_tbl, bit_stream, input,
+                    input_end);
+                if (length == -1)
+                    return rnc::HUF_DECODE_ERROR;
+
+                position += 1;
+                length += 2;
+
+                while (length--) {
+                    *output = output[-position];
+                    output++;
+                }
+            }
+        }
+
+        if (output != output_end)
+            return rnc::FILE_SIZE_MISMATCH;
+
+        if (crc(output_end - output_length, output_length) != unpacked_crc)
+            return rnc::UNPACKED_CRC_ERROR;
+
+        return output_length;
+    }
+}
+
+/*
+ * Minimal RNC packer used to build test files when there is no original
+ * data. Each chunk has its own tables : either every value has a 4 bits
+ * code, or code lengths go from 1 to 15 bits so that long codes are also
+ * decoded. Matches are searched with a hash of the next 3 bytes.
+ */
+namespace packer {
+    //! Max number of bytes unpacked by a chunk
+    const size_t kChunkSize = 4096;
+    //! Biggest number that can be coded with 16 values
+    const size_t kMaxNumber = (1 << 15) - 1;
+
+    /*!
+     * Writes the bits in 16 bits words. Raw bytes are written after the
+     * word that is being filled, and the next word starts after them.
+     */
+    class BitWriter {
+    public:
+        BitWriter() : wordPos_(0), wordBits_(16) {}
+
+        void writeBits(uint32 value, int count) {
+            for (int i = 0; i < count; i++) {
+                if (wordBits_ == 16) {
+                    wordPos_ = out_.size();
+                    out_.push_back(0);
+                    out_.push_back(0);
+                    wordBits_ = 0;
+                }
+                if (value & (1u << i)) {
+                    out_[wordPos_ + static_cast<size_t>(wordBits_ / 8)] |=
+                        static_cast<uint8>(1 << (wordBits_ % 8));
+                }
+                wordBits_++;
+            }
+        }
+
+        void writeRaw(const uint8 *data, size_t size) {
+            out_.insert(out_.end(), data, data + size);
+        }
+
+        std::vector<uint8> &data() { return out_; }
+
+    private:
+        std::vector<uint8> out_;
+        //! Offset of the word being filled
+        size_t wordPos_;
+        //! Number of bits written in that word
+        int wordBits_;
+    };
+
+    void writeBeUint16(uint8 *data, uint16 num) {
+        data[0] = static_cast<uint8>(num >> 8);
+        data[1] = static_cast<uint8>(num & 0xFF);
+    }
+
+    void writeBeUint32(uint8 *data, uint32 num) {
+        writeBeUint16(data, static_cast<uint16>(num >> 16));
+        writeBeUint16(data + 2, static_cast<uint16>(num & 0xFFFF));
+    }
+
+    //! Codes of the 16 values of a table
+    struct Table {
+        int length[16];
+        uint32 code[16];
+    };
+
+    //! Same code assignment as the decoders
+    void makeTable(Table &table, bool longCodes) {
+        for (int j = 0; j < 16; j++) {
+            table.length[j] = longCodes ? std::min(j + 1, 15) : 4;
+        }
+        uint32 code_b = 0;
+        for (int i = 1; i <= 15; ++i) {
+            for (int j = 0; j < 16; ++j) {
+                if (table.length[j] == i) {
+                    table.code[j] = mirror(code_b, i);
+                    ++code_b;
+                }
+            }
+            code_b <<= 1;
+        }
+    }
+
+    void writeTable(BitWriter &writer, const Table &table) {
+        writer.writeBits(16, 5);
+        for (int j = 0; j < 16; j++) {
+            writer.writeBits(static_cast<uint32>(table.length[j]), 4);
+        }
+    }
+
+    //! Writes a number as a value of the table followed by its low bits
+    void writeNumber(BitWriter &writer, const Table &table, size_t number) {
+        int value = 0;
+        while ((number >> value) != 0) {
+            value++;
+        }
+        writer.writeBits(table.code[value], table.length[value]);
+        if (value >= 2) {
+            writer.writeBits(static_cast<uint32>(number) & ((1u << (value - 1)) - 1), value - 1);
+        }
+    }
+
+    //! A run of raw bytes followed by a match, except for the last one
+    struct Step {
+        size_t rawStart;
+        size_t rawLength;
+        size_t distance;
+        size_t length;
+    };
+
+    std::vector<uint8> pack(const std::vector<uint8> &data) {
+        BitWriter writer;
+        writer.writeBits(0, 2);
+
+        std::vector<size_t> lastPos(1 << 16, SIZE_MAX);
+        size_t pos = 0;
+        int nbChunks = 0;
+        while (pos < data.size()) {
+            size_t chunkEnd = std::min(pos + kChunkSize, data.size());
+            std::vector<Step> steps;
+            Step step = { pos, 0, 0, 0 };
+            while (pos < chunkEnd) {
+                size_t length = 0, distance = 0;
+                if (pos + 3 <= chunkEnd) {
+                    size_t hash = ((static_cast<size_t>(data[pos]) << 8)
+                        ^ (static_cast<size_t>(data[pos + 1]) << 4) ^ data[pos + 2]) & 0xFFFF;
+                    size_t candidate = lastPos[hash];
+                    lastPos[hash] = pos;
+                    if (candidate != SIZE_MAX && pos - candidate <= kMaxNumber + 1) {
+                        while (pos + length < chunkEnd && length < kMaxNumber + 2
+                            && data[candidate + length] == data[pos + length]) {
+                            length++;
+                        }
+                        distance = pos - candidate;
+                    }
+                }
+                if (length >= 3) {
+                    step.distance = distance;
+                    step.length = length;
+                    steps.push_back(step);
+                    pos += length;
+                    step.rawStart = pos;
+                    step.rawLength = 0;
+                } else {
+                    // a chunk is shorter than kMaxNumber so is any raw run
+                    step.rawLength++;
+                    pos++;
+                }
+            }
+            steps.push_back(step);
+
+            Table raw, dist, len;
+            makeTable(raw, nbChunks % 2 == 1);
+            makeTable(dist, nbChunks % 3 == 1);
+            makeTable(len, nbChunks % 2 == 0);
+            writeTable(writer, raw);
+            writeTable(writer, dist);
+            writeTable(writer, len);
+            writer.writeBits(static_cast<uint32>(steps.size()), 16);
+            for (size_t i = 0; i < steps.size(); i++) {
+                writeNumber(writer, raw, steps[i].rawLength);
+                if (steps[i].rawLength) {
+                    writer.writeRaw(&data[steps[i].rawStart], steps[i].rawLength);
+                }
+                if (i + 1 < steps.size()) {
+                    writeNumber(writer, dist, steps[i].distance - 1);
+                    writeNumber(writer, len, steps[i].length - 2);
+                }
+            }
+            nbChunks++;
+        }
+
+        std::vector<uint8> &stream = writer.data();
+        std::vector<uint8> packed(18, 0);
+        writeBeUint32(&packed[0], RNC_SIGNATURE);
+        writeBeUint32(&packed[4], static_cast<uint32>(data.size()));
+        writeBeUint32(&packed[8], static_cast<uint32>(stream.size()));
+        std::vector<uint8> copy(data);
+        writeBeUint16(&packed[12], rnc::crc(copy.data(), static_cast<int>(copy.size())));
+        writeBeUint16(&packed[14], rnc::crc(stream.data(), static_cast<int>(stream.size())));
+        packed[17] = static_cast<uint8>(nbChunks);
+        packed.insert(packed.end(), stream.begin(), stream.end());
+        return packed;
+    }
+}
+
+namespace {
+    //! Signature of the function that unpacks a file
+    typedef int (*UnpackFunc)(uint8 *packed_data, uint8 *unpacked_data);
+
+    //! A packed file read from the data directory
+    struct PackedFile {
+        std::string name;
+        std::vector<uint8> packed;
+        int unpackedSize;
+    };
+
+    void printUsage() {
+        printf("usage: rnc-bench [options...] <data dir>\n");
+        printf("    -h, --help            display this help and exit.\n");
+        printf("    -n, --iterations <num> number of times each file is unpacked (default: 20).\n");
+        printf("    -f, --fixtures        unpack files packed by rnc-bench instead of a data dir\n");
+        printf("                          and check that they give back the original data.\n");
+    }
+
+    /*!
+     * Reads all the RNC files of the directory.
+     * Some padding is added after the packed data as the reference
+     * decoder can read a few bytes past the end of the data.
+     */
+    bool readPackedFiles(const fs::path &dir, std::vector<PackedFile> &files) {
+        std::error_code ec;
+        fs::directory_iterator it(dir, ec);
+        if (ec) {
+            printf("Cannot read directory %s\n", dir.string().c_str());
+            return false;
+        }
+
+        for (const fs::directory_entry &entry : it) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+
+            std::ifstream in(entry.path(), std::ios::binary);
+            std::vector<uint8> data((std::istreambuf_iterator<char>(in)),
+                std::istreambuf_iterator<char>());
+            if (data.size() < 18 || READ_BE_UINT32(data.data()) != RNC_SIGNATURE) {
+                continue;
+            }
+
+            PackedFile file;
+            file.name = entry.path().filename().string();
+            file.unpackedSize = rnc::unpackedLength(data.data());
+            data.resize(data.size() + 8, 0);
+            file.packed.swap(data);
+            files.push_back(std::move(file));
+        }
+
+        return true;
+    }
+
+    /*!
+     * Packs generated data with the packer : text with repeated words,
+     * runs of a single byte that are copied from the previous byte,
+     * random bytes that can't be packed, and all of them mixed in a file
+     * of several chunks.
+     * \param files Receives the packed files
+     * \param originals Receives the data of each file
+     */
+    void makeFixtures(std::vector<PackedFile> &files, std::vector<std::vector<uint8>> &originals) {
+        const char *words[] = { "agent ", "persuadertron ", "minigun ", "Eurocorp ", "syndicate " };
+        uint32 seed = 12345;
+        auto next = [&seed]() {
+            seed = seed * 1103515245 + 12345;
+            return (seed >> 16) & 0x7FFF;
+        };
+
+        std::vector<uint8> text, run, noise, mixed;
+        while (text.size() < 3000) {
+            const char *word = words[next() % 5];
+            text.insert(text.end(), word, word + strlen(word));
+        }
+        run.assign(10000, 0x2A);
+        for (int i = 0; i < 5000; i++) {
+            noise.push_back(static_cast<uint8>(next() & 0xFF));
+        }
+        for (int i = 0; i < 6; i++) {
+            mixed.insert(mixed.end(), text.begin(), text.end());
+            mixed.insert(mixed.end(), noise.begin() + i * 500, noise.begin() + i * 500 + 3000);
+            mixed.insert(mixed.end(), run.begin(), run.begin() + 100 * (i + 1));
+        }
+
+        originals.push_back(std::vector<uint8>(1, 0x55));
+        originals.push_back(text);
+        originals.push_back(run);
+        originals.push_back(noise);
+        originals.push_back(mixed);
+        const char *names[] = { "byte", "text", "run", "noise", "mixed" };
+        for (size_t i = 0; i < originals.size(); i++) {
+            PackedFile file;
+            file.name = names[i];
+            file.packed = packer::pack(originals[i]);
+            file.unpackedSize = static_cast<int>(originals[i].size());
+            file.packed.resize(file.packed.size() + 8, 0);
+            files.push_back(std::move(file));
+        }
+    }
+
+    /*!
+     * Unpacks all files the given number of times.
+     * \return the time in seconds or a negative value if a file can't be unpacked
+     */
+    double runDecoder(UnpackFunc unpack, std::vector<PackedFile> &files,
+            int iterations, std::vector<std::vector<uint8>> &outputs) {
+        outputs.resize(files.size());
+        for (size_t i = 0; i < files.size(); i++) {
+            outputs[i].assign(static_cast<size_t>(files[i].unpackedSize), 0);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int n = 0; n < iterations; n++) {
+            for (size_t i = 0; i < files.size(); i++) {
+                int res = unpack(files[i].packed.data(), outputs[i].data());
+                if (res != files[i].unpackedSize) {
+                    printf("%s : %s\n", files[i].name.c_str(), rnc::errorString(res));
+                    return -1.0;
+                }
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+}
+
+/*!
+ * Unpacks all the RNC files of the original data directory with the
+ * current decoder and the reference decoder, prints the speed of both
+ * and checks that they produce exactly the same data.
+ * With --fixtures, the files are packed by the bench itself so the check
+ * runs without the original data.
+ * Returns a non zero value if a file is different.
+ */
+int main(int argc, char *argv[]) {
+    int iterations = 20;
+    const char *dataDir = NULL;
+    bool fixtures = false;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (0 == strcmp("-h", argv[i]) || 0 == strcmp("--help", argv[i])) {
+            printUsage();
+            return 0;
+        } else if (hasValue && (0 == strcmp("-n", argv[i]) || 0 == strcmp("--iterations", argv[i]))) {
+            iterations = atoi(argv[++i]);
+        } else if (0 == strcmp("-f", argv[i]) || 0 == strcmp("--fixtures", argv[i])) {
+            fixtures = true;
+        } else if (argv[i][0] != '-' && dataDir == NULL) {
+            dataDir = argv[i];
+        } else {
+            printf("Unknown or incomplete option : %s\n", argv[i]);
+            printUsage();
+            return 1;
+        }
+    }
+
+    if ((dataDir == NULL && !fixtures) || iterations <= 0) {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<PackedFile> files;
+    std::vector<std::vector<uint8>> originals;
+    if (fixtures) {
+        makeFixtures(files, originals);
+    } else {
+        if (!readPackedFiles(dataDir, files)) {
+            return 1;
+        }
+        if (files.empty()) {
+            printf("No RNC file found in %s\n", dataDir);
+            return 1;
+        }
+    }
+
+    uint64 totalSize = 0;
+    for (const PackedFile &file : files) {
+        totalSize += static_cast<uint64>(file.unpackedSize);
+    }
+
+    std::vector<std::vector<uint8>> refOutputs, outputs;
+    double refTime = runDecoder(reference::unpack, files, iterations, refOutputs);
+    double time = runDecoder(rnc::unpack, files, iterations, outputs);
+    if (refTime < 0.0 || time < 0.0) {
+        return 1;
+    }
+
+    int nbDiff = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        if (refOutputs[i] != outputs[i]) {
+            printf("%s : unpacked data differs from the reference decoder\n", files[i].name.c_str());
+            nbDiff++;
+        } else if (i < originals.size() && outputs[i] != originals[i]) {
+            printf("%s : unpacked data differs from the packed data\n", files[i].name.c_str());
+            nbDiff++;
+        }
+    }
+
+    double mb = static_cast<double>(totalSize) * iterations / (1024.0 * 1024.0);
+    printf("%zu files, %llu bytes unpacked, %d iterations\n", files.size(), totalSize, iterations);
+    printf("%-10s %10s %10s\n", "decoder", "time (s)", "MB/s");
+    printf("%-10s %10.3f %10.1f\n", "reference", refTime, refTime > 0.0 ? mb / refTime : 0.0);
+    printf("%-10s %10.3f %10.1f\n", "current", time, time > 0.0 ? mb / time : 0.0);
+    if (refTime > 0.0 && time > 0.0) {
+        printf("speedup x%.2f\n", refTime / time);
+    }
+
+    return nbDiff == 0 ? 0 : 1;
+}
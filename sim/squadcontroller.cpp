@@ -0,0 +1,137 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include "squadcontroller.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <algorithm>
+
+#include "fs-utils/log/log.h"
+#include "fs-kernel/model/mission.h"
+#include "fs-kernel/model/ped.h"
+#include "fs-kernel/model/squad.h"
+#include "fs-kernel/mgr/agentmanager.h"
+
+const int RandomSquadController::kOrderPeriod = 3000;
+const int RandomSquadController::kOrderRange = 12;
+
+RandomSquadController::RandomSquadController() {
+    lastOrderTime_ = -kOrderPeriod;
+}
+
+void RandomSquadController::update(Mission *pMission, int missionTime) {
+    if (missionTime - lastOrderTime_ < kOrderPeriod) {
+        return;
+    }
+    lastOrderTime_ = missionTime;
+
+    Squad *pSquad = pMission->getSquad();
+    for (size_t i = 0; i < AgentManager::kMaxSlot; i++) {
+        PedInstance *pAgent = pSquad->member(i);
+        if (pAgent == NULL || pAgent->isDead() || pAgent->inVehicle()) {
+            continue;
+        }
+
+        TilePoint dest;
+        if (findDestination(pMission, pAgent, &dest)) {
+            pAgent->addActionWalk(dest, false);
+        }
+    }
+}
+
+/*!
+ * Tries a few random tiles on the agent's level.
+ * \return False if no walkable tile was found
+ */
+bool RandomSquadController::findDestination(Mission *pMission, PedInstance *pAgent, TilePoint *pDest) {
+    for (int attempt = 0; attempt < 8; attempt++) {
+        int x = pAgent->tileX() + rand() % (2 * kOrderRange + 1) - kOrderRange;
+        int y = pAgent->tileY() + rand() % (2 * kOrderRange + 1) - kOrderRange;
+        int z = pAgent->tileZ();
+        if (x < 0 || x >= pMission->mmax_x_ || y < 0 || y >= pMission->mmax_y_) {
+            continue;
+        }
+
+        floodPointDesc *pNode = &(pMission->mdpoints_[x + y * pMission->mmax_x_
+            + z * pMission->mmax_m_xy]);
+        if ((pNode->bfNodeDesc & m_fdWalkable) != 0) {
+            pDest->initFrom(TilePoint(x, y, z));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+ScriptedSquadController::ScriptedSquadController() {
+    next_ = 0;
+}
+
+bool ScriptedSquadController::load(const std::string &path) {
+    std::ifstream file(path.c_str());
+    if (!file) {
+        FSERR(Log::k_FLG_IO, "ScriptedSquadController", "load", ("Cannot open script %s\n", path.c_str()))
+        return false;
+    }
+
+    std::string line;
+    int lineNum = 0;
+    while (std::getline(file, line)) {
+        lineNum++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        Order order;
+        int slot, tx, ty, tz;
+        if (sscanf(line.c_str(), "%d %d %d %d %d", &order.time, &slot, &tx, &ty, &tz) != 5
+            || slot < 0 || slot >= static_cast<int>(AgentManager::kMaxSlot)) {
+            FSERR(Log::k_FLG_IO, "ScriptedSquadController", "load", ("Invalid order line %d in %s\n", lineNum, path.c_str()))
+            return false;
+        }
+        order.slot = static_cast<size_t>(slot);
+        order.dest.initFrom(TilePoint(tx, ty, tz));
+        orders_.push_back(order);
+    }
+
+    std::stable_sort(orders_.begin(), orders_.end(),
+        [](const Order &a, const Order &b) { return a.time < b.time; });
+    next_ = 0;
+
+    return true;
+}
+
+void ScriptedSquadController::update(Mission *pMission, int missionTime) {
+    Squad *pSquad = pMission->getSquad();
+    while (next_ < orders_.size() && orders_[next_].time <= missionTime) {
+        const Order &order = orders_[next_];
+        next_++;
+
+        PedInstance *pAgent = pSquad->member(order.slot);
+        if (pAgent && pAgent->isAlive() && pAgent->inVehicle() == NULL) {
+            pAgent->addActionWalk(order.dest, false);
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#ifndef SIM_SQUADCONTROLLER_H_
+#define SIM_SQUADCONTROLLER_H_
+
+#include <string>
+#include <vector>
+
+#include "fs-utils/common.h"
+#include "fs-kernel/model/position.h"
+
+class Mission;
+class PedInstance;
+
+/*!
+ * Gives orders to the player's squad when a mission is simulated
+ * without a player.
+ */
+class SquadController {
+public:
+    virtual ~SquadController() {}
+
+    /*!
+     * Called before each simulation step.
+     * \param pMission The simulated mission
+     * \param missionTime Time elapsed since the start of the mission
+     */
+    virtual void update(Mission *pMission, int missionTime) = 0;
+};
+
+/*!
+ * Sends each agent to a random walkable tile around him at
+ * regular intervals.
+ * Only rand() is used so a given seed always gives the same orders.
+ */
+class RandomSquadController : public SquadController {
+public:
+    //! Time between two orders
+    static const int kOrderPeriod;
+    //! Max distance in tiles from the agent to his destination
+    static const int kOrderRange;
+
+    RandomSquadController();
+
+    void update(Mission *pMission, int missionTime) override;
+
+private:
+    //! Finds a walkable tile around the agent
+    bool findDestination(Mission *pMission, PedInstance *pAgent, TilePoint *pDest);
+
+    //! Time of the last orders
+    int lastOrderTime_;
+};
+
+/*!
+ * Plays orders read from a text file.
+ * Each line of the file is an order : "<time> <slot> <tx> <ty> <tz>"
+ * where time is in milliseconds since the start of the mission and
+ * slot is the index of the agent in the squad.
+ * Empty lines and lines starting with '#' are ignored.
+ */
+class ScriptedSquadController : public SquadController {
+public:
+    ScriptedSquadController();
+
+    //! Reads the orders from the given file
+    bool load(const std::string &path);
+
+    void update(Mission *pMission, int missionTime) override;
+
+private:
+    //! An order to walk to a destination
+    struct Order {
+        int time;
+        size_t slot;
+        TilePoint dest;
+    };
+
+    //! Orders sorted by time
+    std::vector<Order> orders_;
+    //! Index of the next order to play
+    size_t next_;
+};
+
+#endif  // SIM_SQUADCONTROLLER_H_
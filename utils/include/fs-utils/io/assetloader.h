@@ -0,0 +1,113 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#ifndef UTILS_ASSETLOADER_H_
+#define UTILS_ASSETLOADER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fs-utils/common.h"
+#include "fs-utils/misc/singleton.h"
+
+/*!
+ * Loads original game files in background threads.
+ *
+ * Files are read and decompressed by File::loadOriginalFileSync() in
+ * worker threads. A caller can either wait for the file with a future,
+ * be called back when file is loaded or prefetch a file it will need soon :
+ * File::loadOriginalFile() then returns the prefetched data instead of
+ * reading the file again, so callers don't need to know about the loader.
+ *
+ * The data of a loaded file is allocated with new[] and belongs to the
+ * caller that receives it.
+ */
+class AssetLoader : public Singleton<AssetLoader> {
+public:
+    //! A loaded file
+    struct Asset {
+        //! File content or NULL if file could not be loaded
+        uint8 *data;
+        //! Size of the content
+        size_t size;
+    };
+
+    //! Function called in a worker thread when a file is loaded
+    typedef std::function<void(uint8 *data, size_t size)> Callback;
+
+    //! Default number of workers
+    static const size_t kNbWorkers;
+    //! Max number of prefetched files waiting to be used, older ones are freed
+    static const size_t kMaxPrefetched;
+
+    explicit AssetLoader(size_t nbWorkers = kNbWorkers);
+    ~AssetLoader();
+
+    //! Loads a file in background and returns a future on the result
+    std::future<Asset> load(const std::string& filename);
+    //! Loads a file in background and calls the callback with the result
+    void load(const std::string& filename, const Callback& callback);
+
+    //! Starts loading a file that will be used later
+    void prefetch(const std::string& filename);
+    //! Returns the prefetched data for the file, waiting for the load if needed
+    bool takePrefetched(const std::string& filename, Asset &asset);
+    //! Frees all prefetched files that have not been used
+    void clearPrefetched();
+
+private:
+    //! Main function of a worker thread
+    void workerLoop();
+    //! Adds a task to the queue
+    void push(const std::function<void()> &task);
+    //! Frees the data of a file once it is loaded, without waiting for it
+    void freeInBackground(const std::shared_future<Asset> &asset);
+    //! Returns the key of the file in the prefetched files
+    static std::string prefetchKey(const std::string& filename);
+
+    std::vector<std::thread> workers_;
+    //! Protects the tasks and the prefetched files
+    std::mutex mutex_;
+    //! Signals the workers that a task is ready or that loader is stopping
+    std::condition_variable taskCond_;
+    //! Tasks waiting for a worker
+    std::deque<std::function<void()> > tasks_;
+    //! True when workers must stop
+    bool stopping_;
+    //! Prefetched files by name
+    std::map<std::string, std::shared_future<Asset> > prefetched_;
+    //! Keys of the prefetched files, from the oldest to the most recent
+    std::list<std::string> prefetchOrder_;
+};
+
+#define g_AssetLoader   AssetLoader::singleton()
+
+#endif  // UTILS_ASSETLOADER_H_
@@ -33,6 +33,7 @@
 
 #include "fs-utils/common.h"
 #include "fs-utils/io/configfile.h"
+#include "fs-utils/io/unpackedcache.h"
 
 namespace fs = std::filesystem;
 
@@ -59,7 +60,16 @@ public:
     //*************************************
     // Original files apis
     //*************************************
+    //! Loads a file, using the data prefetched by the AssetLoader if any
     static uint8 *loadOriginalFile(const std::string& filename, size_t &filesize);
+    //! Loads and decompresses a file in the calling thread
+    static uint8 *loadOriginalFileSync(const std::string& filename, size_t &filesize);
+    //! Asks the AssetLoader to load a file that will be used soon
+    static void prefetchOriginalFile(const std::string& filename);
+    //! Saves unpacked files in the cache folder for the next runs
+    static void setUnpackedDiskCacheEnabled(bool enabled) { unpackedCache_.setDiskCacheEnabled(enabled); }
+    //! Returns the counters of the cache of unpacked files
+    static UnpackedFileCache::Stats unpackedCacheStats() { return unpackedCache_.stats(); }
     static FILE *openOriginalFile(const std::string& filename);
 
     //! Tests Syndicate original data for existence and correctness
@@ -75,6 +85,8 @@ public:
     static void getFullPathForSaveSlot(int slot, std::string &path);
     //! Returns the list of game saved names
     static void getGameSavedNames(std::vector<std::string> &files);
+    //! Returns the full path of a file in the cache folder and creates the folder
+    static bool getCacheFullPath(const std::string& filename, fs::path& cacheFullPath);
     static uint8 *loadOriginalFileToMem(const std::string& filename, size_t &filesize);
 
 private:
@@ -96,6 +108,8 @@ private:
     static fs::path userConfFolderPath_;
     /*! The path to the freesynd.ini file and save directory.*/
     static fs::path savePath_;
+    //! Unpacked content of the RNC compressed files
+    static UnpackedFileCache unpackedCache_;
 };
 
 #endif
@@ -0,0 +1,112 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#ifndef UTILS_UNPACKEDCACHE_H_
+#define UTILS_UNPACKEDCACHE_H_
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "fs-utils/common.h"
+
+/*!
+ * Cache of the unpacked content of RNC compressed files.
+ *
+ * A file is identified by its name and the CRC32 of its packed content,
+ * so a modified file is never served from the cache. Unpacked files are
+ * kept in memory in a LRU list limited by a total size. Optionally,
+ * they are also saved in the cache folder so next runs don't have to
+ * unpack them : those files are named after the packed CRC and the
+ * unpacked size, and they are checked with the unpacked CRC stored in
+ * the RNC header.
+ *
+ * The cache can be used by several threads.
+ */
+class UnpackedFileCache {
+public:
+    //! Counters of the cache
+    struct Stats {
+        //! Number of files found in memory
+        uint64 hits;
+        //! Number of files found on disk
+        uint64 diskHits;
+        //! Number of files that had to be unpacked
+        uint64 misses;
+        //! Number of bytes returned from memory or disk
+        uint64 bytesServed;
+        //! Number of bytes unpacked
+        uint64 bytesUnpacked;
+        //! Number of bytes currently in memory
+        size_t bytesCached;
+        //! Number of files currently in memory
+        size_t entries;
+    };
+
+    //! Default max size of the memory cache in bytes
+    static const size_t kDefaultMaxBytes;
+
+    explicit UnpackedFileCache(size_t maxBytes = kDefaultMaxBytes);
+
+    //! Activates the cache on disk
+    void setDiskCacheEnabled(bool enabled);
+
+    //! Returns the unpacked content of a packed file
+    uint8 *unpack(const std::string& filename, uint8 *packedData, size_t packedSize,
+            size_t &unpackedSize);
+
+    //! Returns the counters
+    Stats stats();
+    //! Empties the memory cache
+    void clear();
+
+private:
+    //! An unpacked file in memory
+    struct Entry {
+        std::string key;
+        std::vector<uint8> data;
+    };
+
+    //! Returns a copy of the file in memory or NULL
+    uint8 *findInMemory(const std::string& key, size_t &size);
+    //! Adds a file in memory
+    void addInMemory(const std::string& key, const uint8 *data, size_t size);
+    //! Returns the path of the file on disk
+    static bool diskPath(uint32 packedCrc, size_t size, std::string &path);
+    //! Reads an unpacked file from disk
+    bool readFromDisk(uint32 packedCrc, uint8 *packedData, uint8 *buffer, size_t size);
+    //! Writes an unpacked file on disk
+    void writeToDisk(uint32 packedCrc, const uint8 *buffer, size_t size);
+
+    std::mutex mutex_;
+    size_t maxBytes_;
+    bool diskEnabled_;
+    //! Most recently used files are at the front
+    std::list<Entry> lru_;
+    std::map<std::string, std::list<Entry>::iterator> index_;
+    Stats stats_;
+};
+
+#endif  // UTILS_UNPACKEDCACHE_H_
@@ -72,6 +72,14 @@ class Timer {
          return false;
      }
 
+     /*!
+      * Returns true if the next call to update() with the given
+      * time will reach max. The counter is not changed.
+      */
+     bool willReach(uint32 elapsed) const {
+         return i_counter_ + elapsed > i_max_;
+     }
+
      /*!
       * Set the counter to max so next time update is called,
       * it automatically returns true.
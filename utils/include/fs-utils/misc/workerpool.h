@@ -0,0 +1,95 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#ifndef UTILS_WORKERPOOL_H_
+#define UTILS_WORKERPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "fs-utils/common.h"
+
+namespace fs_utils {
+
+/*!
+ * A fixed set of threads used to run a loop in parallel.
+ *
+ * The loop indexes are split in small ranges that are taken by the
+ * workers and by the calling thread until there is no more range.
+ * run() returns only when all the ranges are done, so a pool
+ * with no worker simply runs the loop in the calling thread.
+ */
+class WorkerPool {
+public:
+    //! Function called on the indexes from first to last (excluded)
+    typedef std::function<void(size_t first, size_t last)> Job;
+
+    //! Max number of workers returned by defaultSize()
+    static const size_t kMaxDefaultWorkers;
+
+    explicit WorkerPool(size_t nbWorkers);
+    ~WorkerPool();
+
+    //! Returns the number of workers, without the calling thread
+    size_t size() const { return workers_.size(); }
+
+    //! Runs the job on all indexes from 0 to count and waits for the end
+    void run(size_t count, const Job &job);
+
+    //! Returns a number of workers that fits the processor
+    static size_t defaultSize();
+
+private:
+    //! Main function of a worker thread
+    void workerLoop();
+    //! Takes ranges of the current job until none is left
+    void runRanges();
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    //! Signals the workers that a job is ready or that pool is stopping
+    std::condition_variable startCond_;
+    //! Signals the calling thread that all workers are done
+    std::condition_variable doneCond_;
+    //! The current job
+    const Job *pJob_;
+    //! Number of indexes of the current job
+    size_t count_;
+    //! Number of indexes in a range
+    size_t rangeSize_;
+    //! First index of the next range to run
+    std::atomic<size_t> nextIndex_;
+    //! Number of workers still running the current job
+    size_t busyWorkers_;
+    //! Incremented for each job so workers know there's a new one
+    uint32 generation_;
+    bool stopping_;
+};
+
+}
+
+#endif  // UTILS_WORKERPOOL_H_
@@ -0,0 +1,231 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include "fs-utils/io/assetloader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+
+#include "fs-utils/io/file.h"
+#include "fs-utils/log/log.h"
+
+const size_t AssetLoader::kNbWorkers = 2;
+const size_t AssetLoader::kMaxPrefetched = 8;
+
+AssetLoader::AssetLoader(size_t nbWorkers) {
+    stopping_ = false;
+    for (size_t i = 0; i < nbWorkers; i++) {
+        workers_.push_back(std::thread(&AssetLoader::workerLoop, this));
+    }
+}
+
+/*!
+ * Workers finish the tasks in the queue before stopping, then the
+ * prefetched files that were not used are freed.
+ */
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    taskCond_.notify_all();
+    for (std::vector<std::thread>::iterator it = workers_.begin();
+        it != workers_.end(); ++it)
+    {
+        it->join();
+    }
+
+    clearPrefetched();
+}
+
+void AssetLoader::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            taskCond_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                // loader is stopping
+                return;
+            }
+            task = tasks_.front();
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+/*!
+ * Without worker, the task is run immediately in the calling thread.
+ */
+void AssetLoader::push(const std::function<void()> &task) {
+    if (workers_.empty()) {
+        task();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(task);
+    }
+    taskCond_.notify_one();
+}
+
+std::string AssetLoader::prefetchKey(const std::string& filename) {
+    std::string key = filename;
+    std::transform(key.begin(), key.end(), key.begin(),
+                [](unsigned char c){
+                    return static_cast<char>(std::tolower(c)); }
+                );
+    return key;
+}
+
+/*!
+ * \param filename Name of the original file
+ * \return a future that holds the loaded file
+ */
+std::future<AssetLoader::Asset> AssetLoader::load(const std::string& filename) {
+    std::shared_ptr<std::promise<Asset> > pPromise = std::make_shared<std::promise<Asset> >();
+    std::future<Asset> result = pPromise->get_future();
+
+    push([pPromise, filename] {
+        Asset asset;
+        asset.data = File::loadOriginalFileSync(filename, asset.size);
+        pPromise->set_value(asset);
+    });
+
+    return result;
+}
+
+/*!
+ * The callback is called in the worker thread, so it must take care
+ * of the synchronization with the rest of the application.
+ * \param filename Name of the original file
+ * \param callback Function that receives the file data
+ */
+void AssetLoader::load(const std::string& filename, const Callback& callback) {
+    push([filename, callback] {
+        size_t size = 0;
+        uint8 *data = File::loadOriginalFileSync(filename, size);
+        callback(data, size);
+    });
+}
+
+/*!
+ * Nothing is done if the file is already prefetched, except that it becomes
+ * the most recent one. When too many files are waiting to be used, the
+ * oldest one is freed by a worker : it may be a file that will never be
+ * used, like the game file of a mission the player did not start.
+ * \param filename Name of the original file
+ */
+void AssetLoader::prefetch(const std::string& filename) {
+    std::string key = prefetchKey(filename);
+    std::shared_future<Asset> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (prefetched_.find(key) != prefetched_.end()) {
+            prefetchOrder_.remove(key);
+            prefetchOrder_.push_back(key);
+            return;
+        }
+
+        if (prefetched_.size() >= kMaxPrefetched) {
+            const std::string &oldest = prefetchOrder_.front();
+            LOG(Log::k_FLG_IO, "AssetLoader", "prefetch", ("evicting prefetched file %s", oldest.c_str()))
+            evicted = prefetched_[oldest];
+            prefetched_.erase(oldest);
+            prefetchOrder_.pop_front();
+        }
+    }
+
+    if (evicted.valid()) {
+        freeInBackground(evicted);
+    }
+
+    LOG(Log::k_FLG_IO, "AssetLoader", "prefetch", ("prefetching file %s", filename.c_str()))
+    std::shared_future<Asset> asset = load(filename).share();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (prefetched_.insert(std::make_pair(key, asset)).second) {
+            prefetchOrder_.push_back(key);
+            return;
+        }
+    }
+
+    // another thread has prefetched the same file in the meantime
+    freeInBackground(asset);
+}
+
+/*!
+ * The file may still be loading : a task waits for the end of the loading
+ * and frees the data, so the caller is not blocked. The loading task was
+ * queued before, so it is never behind that task.
+ * \param asset The file to free
+ */
+void AssetLoader::freeInBackground(const std::shared_future<Asset> &asset) {
+    push([asset] {
+        delete[] asset.get().data;
+    });
+}
+
+/*!
+ * The file is removed from the prefetched files : the caller owns
+ * the data.
+ * \param filename Name of the original file
+ * \param asset Set with the loaded file
+ * \return False if the file was not prefetched.
+ */
+bool AssetLoader::takePrefetched(const std::string& filename, Asset &asset) {
+    std::shared_future<Asset> prefetched;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<std::string, std::shared_future<Asset> >::iterator it =
+            prefetched_.find(prefetchKey(filename));
+        if (it == prefetched_.end()) {
+            return false;
+        }
+        prefetched = it->second;
+        prefetched_.erase(it);
+        prefetchOrder_.remove(prefetchKey(filename));
+    }
+
+    asset = prefetched.get();
+    return true;
+}
+
+void AssetLoader::clearPrefetched() {
+    std::map<std::string, std::shared_future<Asset> > toFree;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        toFree.swap(prefetched_);
+        prefetchOrder_.clear();
+    }
+
+    for (std::map<std::string, std::shared_future<Asset> >::iterator it = toFree.begin();
+        it != toFree.end(); ++it)
+    {
+        delete[] it->second.get().data;
+    }
+}
@@ -24,10 +24,24 @@
 
 #include "fs-utils/crc/dernc.h"
 
+#include <string.h>
+
 namespace RNC_INTERNAL {
+    //! Number of bits used to index the Huffman lookup tables
+    const int kLookupBits = 9;
+    const uint32 kLookupMask = (1 << kLookupBits) - 1;
+
+    /*!
+     * The packed stream is read by 16 bits words. The buffer is refilled
+     * to hold more than 48 bits, so a code and its extra bits are always
+     * read without refilling.
+     */
     struct BitStream {
-        uint32 bit_buffer;      // Holds between 16 and 32 bits
+        uint64 bit_buffer;      // Next bits of the stream, first bit is bit 0
         int bit_count;          // How many bits does bitbuf hold?
+        const uint8 *data;      // Packed data
+        size_t pos;             // Offset of the next word to load in data
+        size_t size;            // Size of the packed data
     };
 
     struct HuffmanTable {
@@ -37,78 +51,133 @@ namespace RNC_INTERNAL {
             int code_length;
             int value;
         } table[32];
+        // For each value of the next kLookupBits bits, code length in the
+        // high byte and value in the low byte of the matching node, or 0
+        // when the code is longer than kLookupBits
+        uint16 lookup[1 << kLookupBits];
     };
 
-    static uint16 crc_table[256];
-    static bool is_crc_setup = false;
+    //! Number of bytes processed by each step of the CRC
+    const int kCrcSlices = 8;
 
-    void setupCRCTable() {
-        uint16 temp;
+    /*!
+     * CRC tables : files can be unpacked by several threads.
+     * values[k][i] is the CRC of byte i followed by k null bytes, so
+     * the CRC can be updated with 8 bytes at a time.
+     */
+    struct CRCTable {
+        uint16 values[kCrcSlices][256];
 
-        for (int i = 0; i < 256; ++i) {
-            temp = i;
+        CRCTable() {
+            uint16 temp;
 
-            for (int j = 0; j < 8; ++j)
-                temp = (temp & 1 ? (temp >> 1) ^ 0xA001 : temp >> 1);
+            for (int i = 0; i < 256; ++i) {
+                temp = i;
 
-            crc_table[i] = temp;
-        } is_crc_setup = true;
-    }
+                for (int j = 0; j < 8; ++j)
+                    temp = (temp & 1 ? (temp >> 1) ^ 0xA001 : temp >> 1);
+
+                values[0][i] = temp;
+            }
 
-    uint32 bitPeek(BitStream &bit_stream, uint32 mask) {
-        return bit_stream.bit_buffer &mask;
+            for (int k = 1; k < kCrcSlices; ++k)
+                for (int i = 0; i < 256; ++i)
+                    values[k][i] = (values[k - 1][i] >> 8) ^
+                        values[0][values[k - 1][i] & 0xff];
+        }
+    };
+
+    const CRCTable &crcTable() {
+        static const CRCTable table;
+        return table;
     }
 
-    static void bitAdvance(BitStream &bit_stream, int count,
-            uint8 *&packed_data) {
-        bit_stream.bit_buffer >>= count;
-        bit_stream.bit_count -= count;
-        if (bit_stream.bit_count < 16) {
-            packed_data += 2;
-            bit_stream.bit_buffer |=
-                (READ_LE_UINT16(packed_data) << bit_stream.bit_count);
+    /*!
+     * Words after the end of the data are read as 0. A single byte
+     * at the end of the data is the low byte of the last word.
+     */
+    inline void bitRefill(BitStream &bit_stream) {
+        if (bit_stream.bit_count > 48)
+            return;
+
+        if (bit_stream.pos + 8 <= bit_stream.size) {
+            // Words are little endian so the stream can be loaded by 8 bytes
+            int words = (64 - bit_stream.bit_count) / 16;
+            uint64 bits = 0;
+            for (int i = 7; i >= 0; --i)
+                bits = (bits << 8) | bit_stream.data[bit_stream.pos + static_cast<size_t>(i)];
+            if (words < 4)
+                bits &= (1ULL << (16 * words)) - 1;
+            bit_stream.bit_buffer |= bits << bit_stream.bit_count;
+            bit_stream.bit_count += 16 * words;
+            bit_stream.pos += static_cast<size_t>(2 * words);
+            return;
+        }
+
+        while (bit_stream.bit_count <= 48) {
+            uint32 word = 0;
+            if (bit_stream.pos + 1 < bit_stream.size)
+                word = READ_LE_UINT16(bit_stream.data + bit_stream.pos);
+            else if (bit_stream.pos < bit_stream.size)
+                word = bit_stream.data[bit_stream.pos];
+            bit_stream.bit_buffer |= static_cast<uint64>(word) << bit_stream.bit_count;
             bit_stream.bit_count += 16;
+            bit_stream.pos += 2;
         }
     }
 
-    static void bitAdvance8(BitStream &bit_stream, int count,
-            uint8 *&packed_data, uint8 *packed_data_end) {
+    inline uint32 bitPeek(BitStream &bit_stream, int count) {
+        return static_cast<uint32>(bit_stream.bit_buffer & ((1ULL << count) - 1));
+    }
+
+    inline void bitAdvance(BitStream &bit_stream, int count) {
         bit_stream.bit_buffer >>= count;
         bit_stream.bit_count -= count;
-        if (bit_stream.bit_count < 16) {
-            packed_data += 2;
-            if (packed_data < packed_data_end) {
-                bit_stream.bit_buffer |=
-                    ((uint32)(*packed_data) << bit_stream.bit_count);
-                bit_stream.bit_count += 16;
-            }
-        }
     }
 
-    uint32 bitRead(BitStream &bit_stream, uint32 mask, int count,
-            uint8 *&packed_data) {
-        uint32 result = bitPeek(bit_stream, mask);
-        bitAdvance(bit_stream, count, packed_data);
+    inline uint32 bitRead(BitStream &bit_stream, int count) {
+        bitRefill(bit_stream);
+        uint32 result = bitPeek(bit_stream, count);
+        bitAdvance(bit_stream, count);
         return result;
     }
 
-    uint32 bitRead8(BitStream &bit_stream, uint32 mask, int count,
-            uint8 *&packed_data, uint8 *packed_data_end) {
-        uint32 result = bitPeek(bit_stream, mask);
-        bitAdvance8(bit_stream, count, packed_data, packed_data_end);
-        return result;
+    void bitReadInit(BitStream &bit_stream, const uint8 *packed_data, size_t size) {
+        bit_stream.bit_buffer = 0;
+        bit_stream.bit_count = 0;
+        bit_stream.data = packed_data;
+        bit_stream.pos = 0;
+        bit_stream.size = size;
+        bitRefill(bit_stream);
+    }
+
+    /*!
+     * Raw bytes are stored in the packed data right after the word
+     * that holds the last bits read : the words loaded in advance are
+     * given back before returning the offset of the raw bytes.
+     */
+    size_t bitRawOffset(BitStream &bit_stream) {
+        return bit_stream.pos - 2 * static_cast<size_t>(bit_stream.bit_count / 16);
+    }
+
+    //! Continues the bit stream after raw bytes that end at the given offset
+    void bitSkipRaw(BitStream &bit_stream, size_t offset) {
+        bit_stream.bit_count %= 16;
+        bit_stream.bit_buffer &= (1ULL << bit_stream.bit_count) - 1;
+        bit_stream.pos = offset;
+        bitRefill(bit_stream);
     }
 
     void readHuffmanTable(HuffmanTable &huffman_table,
-            BitStream &bit_stream, uint8 *&packed_data) {
-        int count = bitRead(bit_stream, 0x1f, 5, packed_data);
+            BitStream &bit_stream) {
+        int count = bitRead(bit_stream, 5);
         if (!count)
             return;
 
         int leaf_max = 1;
         int leaf_length[32];
         for (int i = 0; i < count; ++i) {
-            leaf_length[i] = bitRead(bit_stream, 0x0f, 4, packed_data);
+            leaf_length[i] = bitRead(bit_stream, 4);
             if (leaf_max < leaf_length[i])
                 leaf_max = leaf_length[i];
         }
@@ -129,70 +198,60 @@ namespace RNC_INTERNAL {
         }
 
         huffman_table.node_count = node_count;
+
+        // Nodes are sorted by code length, so the first node that fills
+        // an entry is the one a linear search would find
+        memset(huffman_table.lookup, 0, sizeof(huffman_table.lookup));
+        for (int i = 0; i < node_count; ++i) {
+            int length = huffman_table.table[i].code_length;
+            if (length > kLookupBits)
+                break;
+            uint16 entry = static_cast<uint16>((length << 8) | huffman_table.table[i].value);
+            for (uint32 idx = huffman_table.table[i].code; idx <= kLookupMask;
+                idx += (1 << length)) {
+                if (huffman_table.lookup[idx] == 0)
+                    huffman_table.lookup[idx] = entry;
+            }
+        }
     }
 
     int readHuffmanData(HuffmanTable &huffman_table,
-            BitStream &bit_stream, uint8 *&packed_data,
-            uint8 *packed_data_end) {
-        int i;
-        uint32 mask;
-
-        for (i = 0; i < huffman_table.node_count; ++i) {
-            mask = (1 << huffman_table.table[i].code_length) - 1;
-            if (bitPeek(bit_stream, mask) == huffman_table.table[i].code)
-                break;
+            BitStream &bit_stream) {
+        bitRefill(bit_stream);
+
+        int code_length, value;
+        uint16 entry = huffman_table.lookup[bit_stream.bit_buffer & kLookupMask];
+        if (entry) {
+            code_length = entry >> 8;
+            value = entry & 0xFF;
+        } else {
+            // Code is longer than the lookup index
+            int i;
+            for (i = 0; i < huffman_table.node_count; ++i) {
+                code_length = huffman_table.table[i].code_length;
+                if (code_length > kLookupBits &&
+                    bitPeek(bit_stream, code_length) == huffman_table.table[i].code)
+                    break;
+            }
+
+            if (i == huffman_table.node_count)
+                return -1;
+            value = huffman_table.table[i].value;
         }
 
-        if (i == huffman_table.node_count)
-            return -1;
-        if ((packed_data + 2) < packed_data_end)
-            bitAdvance(bit_stream, huffman_table.table[i].code_length,
-                   packed_data);
-        else
-            bitAdvance8(bit_stream, huffman_table.table[i].code_length,
-                   packed_data, packed_data_end);
+        bitAdvance(bit_stream, code_length);
 
-        uint32 result = huffman_table.table[i].value;
+        uint32 result = static_cast<uint32>(value);
 
         if (result >= 2) {
             result = 1 << (result - 1);
-            if ((packed_data + 2) < packed_data_end)
-                result |= bitRead(bit_stream, result - 1,
-                        huffman_table.table[i].value - 1, packed_data);
-            else
-                result |= bitRead8(bit_stream, result - 1,
-                        huffman_table.table[i].value - 1, packed_data,
-                        packed_data_end);
+            result |= bitPeek(bit_stream, value - 1);
+            bitAdvance(bit_stream, value - 1);
         }
 
         return result;
     }
 
-    void bitReadInit(BitStream &bit_stream, uint8 *&packed_data) {
-        bit_stream.bit_buffer = READ_LE_UINT16(packed_data);
-        bit_stream.bit_count = 16;
-    }
-
-    void bitReadFix(BitStream &bit_stream, uint8 *&packed_data) {
-        bit_stream.bit_count -= 16;
-        // Remove the top 16 bits
-        bit_stream.bit_buffer &= (1 << bit_stream.bit_count) - 1;
-        // Replace with the data at the current input position
-        bit_stream.bit_buffer |=
-            (READ_LE_UINT16(packed_data) << bit_stream.bit_count);
-        bit_stream.bit_count += 16;
-    }
-
-    void bitReadFix8(BitStream &bit_stream, uint8 *&packed_data) {
-        bit_stream.bit_count -= 16;
-        // Remove the top 16 bits
-        bit_stream.bit_buffer &= (1 << bit_stream.bit_count) - 1;
-        // Replace with the data at the current input position
-        bit_stream.bit_buffer |=
-            ((uint32)(*packed_data) << bit_stream.bit_count);
-        bit_stream.bit_count += 16;
-    }
-
 }
 
 const char *const rnc::errorString(int error_code) {
@@ -225,14 +284,21 @@ int rnc::unpackedLength(uint8 *packed_data) {
 
 uint16 rnc::crc(uint8 *data, int data_length) {
     using namespace RNC_INTERNAL;
-    if (!is_crc_setup)
-        setupCRCTable();
+    const CRCTable &crc_table = crcTable();
 
     uint16 result = 0;
-    do {
+    for (; data_length >= kCrcSlices; data_length -= kCrcSlices, data += kCrcSlices) {
+        uint16 low = result ^ READ_LE_UINT16(data);
+        result = crc_table.values[7][low & 0xff] ^ crc_table.values[6][low >> 8] ^
+            crc_table.values[5][data[2]] ^ crc_table.values[4][data[3]] ^
+            crc_table.values[3][data[4]] ^ crc_table.values[2][data[5]] ^
+            crc_table.values[1][data[6]] ^ crc_table.values[0][data[7]];
+    }
+
+    for (; data_length > 0; --data_length) {
         result ^= *data++;
-        result = (result >> 8) ^ crc_table[result & 0xff];
-    } while (--data_length);
+        result = (result >> 8) ^ crc_table.values[0][result & 0xff];
+    }
 
     return result;
 }
@@ -261,55 +327,71 @@ int rnc::unpack(uint8 *packed_data, uint8 *unpacked_data) {
 
     BitStream bit_stream;
 
-    bitReadInit(bit_stream, input);
-    bitAdvance(bit_stream, 2, input);   // Discard first two bits
+    bitReadInit(bit_stream, input, static_cast<size_t>(input_length));
+    bitAdvance(bit_stream, 2);   // Discard first two bits
 
     // Process compressed chunks
     HuffmanTable raw_huff_tbl, dist_huff_tbl, len_huff_tbl;
+    raw_huff_tbl.node_count = dist_huff_tbl.node_count = len_huff_tbl.node_count = 0;
+    memset(raw_huff_tbl.lookup, 0, sizeof(raw_huff_tbl.lookup));
+    memset(dist_huff_tbl.lookup, 0, sizeof(dist_huff_tbl.lookup));
+    memset(len_huff_tbl.lookup, 0, sizeof(len_huff_tbl.lookup));
     int length, position;
     uint32 ch_count;
     while (output < output_end) {
-        readHuffmanTable(raw_huff_tbl, bit_stream, input);
-        readHuffmanTable(dist_huff_tbl, bit_stream, input);
-        readHuffmanTable(len_huff_tbl, bit_stream, input);
+        readHuffmanTable(raw_huff_tbl, bit_stream);
+        readHuffmanTable(dist_huff_tbl, bit_stream);
+        readHuffmanTable(len_huff_tbl, bit_stream);
 
-        ch_count = bitRead(bit_stream, 0xffff, 16, input);
+        ch_count = bitRead(bit_stream, 16);
 
         while (1) {
-            length = readHuffmanData(raw_huff_tbl, bit_stream, input,
-                input_end);
+            length = readHuffmanData(raw_huff_tbl, bit_stream);
             if (length == -1)
                 return HUF_DECODE_ERROR;
 
             if (length) {
-                while (length--)
-                    *output++ = *input++;
-                if ((input + 1) < input_end)
-                    bitReadFix(bit_stream, input);
-                else
-                    bitReadFix8(bit_stream, input);
+                size_t raw_offset = bitRawOffset(bit_stream);
+                if (raw_offset + static_cast<size_t>(length) > bit_stream.size
+                    || length > output_end - output)
+                    return FILE_SIZE_MISMATCH;
+                memcpy(output, input + raw_offset, static_cast<size_t>(length));
+                output += length;
+                bitSkipRaw(bit_stream, raw_offset + static_cast<size_t>(length));
             }
 
             if (--ch_count <= 0)
                 break;
 
-            position = readHuffmanData(dist_huff_tbl, bit_stream, input,
-                input_end);
+            position = readHuffmanData(dist_huff_tbl, bit_stream);
             if (position == -1)
                 return HUF_DECODE_ERROR;
 
-            length = readHuffmanData(len_huff_tbl, bit_stream, input,
-                input_end);
+            length = readHuffmanData(len_huff_tbl, bit_stream);
             if (length == -1)
                 return HUF_DECODE_ERROR;
 
             position += 1;
             length += 2;
 
-            while (length--) {
-                *output = output[-position];
-                output++;
+            if (position > output - unpacked_data)
+                return HUF_DECODE_ERROR;
+            if (length > output_end - output)
+                return FILE_SIZE_MISMATCH;
+
+            // Copy by blocks of 8 bytes when a block does not overlap
+            // the bytes it copies
+            const uint8 *source = output - position;
+            if (position >= 8) {
+                while (length >= 8) {
+                    memcpy(output, source, 8);
+                    output += 8;
+                    source += 8;
+                    length -= 8;
+                }
             }
+            while (length--)
+                *output++ = *source++;
         }
     }
 
@@ -50,6 +50,7 @@
 #endif
 
 #include "fs-utils/io/file.h"
+#include "fs-utils/io/assetloader.h"
 #include "fs-utils/crc/ccrc32.h"
 #include "fs-utils/crc/dernc.h"
 #include "fs-utils/log/log.h"
@@ -60,6 +61,7 @@ fs::path File::dataPath_ = "./data/";
 fs::path File::ourDataPath_ = "./data/";
 fs::path File::savePath_ = ".";
 fs::path File::userConfFolderPath_ = "";
+UnpackedFileCache File::unpackedCache_;
 
 #ifdef _WIN32
 static std::string exeFolder() {
@@ -286,6 +288,25 @@ std::string File::getFreesyndDataFullPath(const std::string& filename) {
     return (ourDataPath_ / filename).string();
 }
 
+/*!
+ * The cache folder is located in the user config folder. It holds files
+ * computed by the application that can be deleted at any time.
+ * \param filename Name of the file in the cache folder
+ * \param cacheFullPath Set with the full path of the file
+ * \return False if the cache folder does not exist and could not be created.
+ */
+bool File::getCacheFullPath(const std::string& filename, fs::path& cacheFullPath) {
+    fs::path cachePath = userConfFolderPath_ / "cache";
+    std::error_code ec;
+    if (!fs::exists(cachePath, ec) && !fs::create_directories(cachePath, ec)) {
+        FSERR(Log::k_FLG_IO, "File", "getCacheFullPath", ("Could not create cache folder %s.\n", cachePath.string().c_str()));
+        return false;
+    }
+
+    cacheFullPath = cachePath / filename;
+    return true;
+}
+
 void File::getFullPathForSaveSlot(int slot, std::string &path) {
     std::ostringstream filename;
     if (slot < 10) {
@@ -401,28 +422,50 @@ void File::upsertSaveDataFolder(const std::string& path) {
     LOG(Log::k_FLG_IO, "File", "setSaveDataFolder", ("set save path to %s", path.c_str()));
 }
 
+/*!
+ * If the file has been prefetched, the method waits for the end of the
+ * loading if needed and returns the prefetched data.
+ * \param filename Name of the original file
+ * \param filesize Set with the size of the file
+ * \return NULL if file cannot be read.
+ */
 uint8 *File::loadOriginalFile(const std::string& filename, size_t &filesize) {
+    AssetLoader *pLoader = AssetLoader::singletonPtr();
+    AssetLoader::Asset asset;
+    if (pLoader && pLoader->takePrefetched(filename, asset)) {
+        filesize = asset.size;
+        return asset.data;
+    }
+
+    return loadOriginalFileSync(filename, filesize);
+}
+
+/*!
+ * Nothing is done if there is no AssetLoader.
+ * \param filename Name of the original file
+ */
+void File::prefetchOriginalFile(const std::string& filename) {
+    AssetLoader *pLoader = AssetLoader::singletonPtr();
+    if (pLoader) {
+        pLoader->prefetch(filename);
+    }
+}
+
+/*!
+ * This method can be called from any thread.
+ * \param filename Name of the original file
+ * \param filesize Set with the size of the file
+ * \return NULL if file cannot be read.
+ */
+uint8 *File::loadOriginalFileSync(const std::string& filename, size_t &filesize) {
     uint8 *data = loadOriginalFileToMem(filename, filesize);
     if (data) {
         if (READ_BE_UINT32(data) == RNC_SIGNATURE) {    //File is RNC compressed
-            filesize = rnc::unpackedLength(data);
-            assert(filesize > 0);
-            uint8 *buffer = new uint8[filesize + 1];
-            buffer[filesize] = '\0';
-            int result = rnc::unpack(data, buffer);
+            // the cache returns a copy of the file if it has already been unpacked
+            size_t unpackedSize = 0;
+            uint8 *buffer = unpackedCache_.unpack(filename, data, filesize, unpackedSize);
             delete[] data;
-
-            if (result < 0) {
-                FSERR(Log::k_FLG_IO, "File", "loadFile", ("Error loading file: %s!", rnc::errorString(result)));
-                filesize = 0;
-                delete[] buffer;
-            }
-
-            if (result != filesize) {
-                FSERR(Log::k_FLG_IO, "File", "loadFile", ("Uncompressed size mismatch for file %s!\n", filename.c_str()));
-                filesize = 0;
-                delete[] buffer;
-            }
+            filesize = buffer ? unpackedSize : 0;
 
             return buffer;
         }
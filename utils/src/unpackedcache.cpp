@@ -0,0 +1,252 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include "fs-utils/io/unpackedcache.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include "fs-utils/crc/ccrc32.h"
+#include "fs-utils/crc/dernc.h"
+#include "fs-utils/io/file.h"
+#include "fs-utils/log/log.h"
+
+const size_t UnpackedFileCache::kDefaultMaxBytes = 16 * 1024 * 1024;
+
+UnpackedFileCache::UnpackedFileCache(size_t maxBytes) {
+    maxBytes_ = maxBytes;
+    diskEnabled_ = false;
+    memset(&stats_, 0, sizeof(Stats));
+}
+
+void UnpackedFileCache::setDiskCacheEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    diskEnabled_ = enabled;
+}
+
+/*!
+ * The returned buffer has one more byte set to 0 after the content.
+ * \param filename Name of the file used to identify the file in the cache
+ * \param packedData Packed content of the file
+ * \param packedSize Size of the packed content
+ * \param unpackedSize Set with the size of the unpacked content
+ * \return a buffer that the caller must delete or NULL if file could
+ * not be unpacked.
+ */
+uint8 *UnpackedFileCache::unpack(const std::string& filename, uint8 *packedData,
+        size_t packedSize, size_t &unpackedSize) {
+    CCRC32 crc32;
+    uint32 packedCrc = crc32.FullCRC(packedData, packedSize);
+
+    std::ostringstream keyStream;
+    keyStream << filename << ':' << std::hex << std::setfill('0') << std::setw(8) << packedCrc;
+    std::string key = keyStream.str();
+    std::transform(key.begin(), key.end(), key.begin(),
+                [](unsigned char c){
+                    return static_cast<char>(std::tolower(c)); }
+                );
+
+    uint8 *buffer = findInMemory(key, unpackedSize);
+    if (buffer) {
+        return buffer;
+    }
+
+    int length = rnc::unpackedLength(packedData);
+    if (length <= 0) {
+        FSERR(Log::k_FLG_IO, "UnpackedFileCache", "unpack", ("Invalid unpacked size for file %s!\n", filename.c_str()));
+        return NULL;
+    }
+    size_t size = static_cast<size_t>(length);
+    buffer = new uint8[size + 1];
+    buffer[size] = '\0';
+
+    bool diskEnabled;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        diskEnabled = diskEnabled_;
+    }
+
+    if (diskEnabled && readFromDisk(packedCrc, packedData, buffer, size)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.diskHits++;
+        stats_.bytesServed += size;
+    } else {
+        int result = rnc::unpack(packedData, buffer);
+        if (result < 0) {
+            FSERR(Log::k_FLG_IO, "UnpackedFileCache", "unpack", ("Error loading file %s: %s!\n", filename.c_str(), rnc::errorString(result)));
+            delete[] buffer;
+            return NULL;
+        }
+        if (result != length) {
+            FSERR(Log::k_FLG_IO, "UnpackedFileCache", "unpack", ("Uncompressed size mismatch for file %s!\n", filename.c_str()));
+            delete[] buffer;
+            return NULL;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.misses++;
+            stats_.bytesUnpacked += size;
+        }
+
+        if (diskEnabled) {
+            writeToDisk(packedCrc, buffer, size);
+        }
+    }
+
+    addInMemory(key, buffer, size);
+    unpackedSize = size;
+    return buffer;
+}
+
+uint8 *UnpackedFileCache::findInMemory(const std::string& key, size_t &size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<std::string, std::list<Entry>::iterator>::iterator it = index_.find(key);
+    if (it == index_.end()) {
+        return NULL;
+    }
+
+    // moves the file at the front of the list
+    lru_.splice(lru_.begin(), lru_, it->second);
+
+    const std::vector<uint8> &data = it->second->data;
+    size = data.size();
+    uint8 *buffer = new uint8[size + 1];
+    memcpy(buffer, data.data(), size);
+    buffer[size] = '\0';
+
+    stats_.hits++;
+    stats_.bytesServed += size;
+    return buffer;
+}
+
+/*!
+ * Least recently used files are removed until the new file fits in the
+ * memory limit. A file bigger than the limit is not kept.
+ */
+void UnpackedFileCache::addInMemory(const std::string& key, const uint8 *data, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (size > maxBytes_ || index_.find(key) != index_.end()) {
+        return;
+    }
+
+    while (!lru_.empty() && stats_.bytesCached + size > maxBytes_) {
+        stats_.bytesCached -= lru_.back().data.size();
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+    }
+
+    lru_.push_front(Entry());
+    lru_.front().key = key;
+    lru_.front().data.assign(data, data + size);
+    index_[key] = lru_.begin();
+    stats_.bytesCached += size;
+    stats_.entries = lru_.size();
+}
+
+UnpackedFileCache::Stats UnpackedFileCache::stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.entries = lru_.size();
+    return stats_;
+}
+
+void UnpackedFileCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+    stats_.bytesCached = 0;
+    stats_.entries = 0;
+}
+
+bool UnpackedFileCache::diskPath(uint32 packedCrc, size_t size, std::string &path) {
+    std::ostringstream filename;
+    filename << std::hex << std::setfill('0') << std::setw(8) << packedCrc
+        << '-' << std::dec << size << ".unp";
+
+    fs::path fullPath;
+    if (!File::getCacheFullPath(filename.str(), fullPath)) {
+        return false;
+    }
+    path.assign(fullPath.string());
+    return true;
+}
+
+/*!
+ * The content is checked with the CRC of the unpacked data that is
+ * stored in the RNC header.
+ */
+bool UnpackedFileCache::readFromDisk(uint32 packedCrc, uint8 *packedData, uint8 *buffer, size_t size) {
+    std::string path;
+    if (!diskPath(packedCrc, size, path)) {
+        return false;
+    }
+
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (fp == NULL) {
+        return false;
+    }
+    bool read = fread(buffer, size, 1, fp) == 1;
+    fclose(fp);
+
+    if (read && rnc::crc(buffer, static_cast<int>(size)) != READ_BE_UINT16(packedData + 12)) {
+        FSERR(Log::k_FLG_IO, "UnpackedFileCache", "readFromDisk", ("Corrupted cache file %s\n", path.c_str()));
+        read = false;
+    }
+    return read;
+}
+
+/*!
+ * The file is first written with a temporary name and then renamed, so
+ * an interrupted write does not leave a partial file.
+ */
+void UnpackedFileCache::writeToDisk(uint32 packedCrc, const uint8 *buffer, size_t size) {
+    std::string path;
+    if (!diskPath(packedCrc, size, path)) {
+        return;
+    }
+
+    std::ostringstream tmpPath;
+    tmpPath << path << '.' << std::this_thread::get_id() << ".tmp";
+    FILE *fp = fopen(tmpPath.str().c_str(), "wb");
+    if (fp == NULL) {
+        FSERR(Log::k_FLG_IO, "UnpackedFileCache", "writeToDisk", ("Cannot create cache file %s\n", tmpPath.str().c_str()));
+        return;
+    }
+    bool written = fwrite(buffer, size, 1, fp) == 1;
+    written = (fclose(fp) == 0) && written;
+
+    std::error_code ec;
+    if (written) {
+        fs::rename(tmpPath.str(), path, ec);
+        written = !ec;
+    }
+    if (!written) {
+        FSERR(Log::k_FLG_IO, "UnpackedFileCache", "writeToDisk", ("Cannot write cache file %s\n", path.c_str()));
+        fs::remove(tmpPath.str(), ec);
+    }
+}
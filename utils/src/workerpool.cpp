@@ -0,0 +1,140 @@
+/************************************************************************
+ *                                                                      *
+ *  FreeSynd - a remake of the classic Bullfrog game "Syndicate".       *
+ *                                                                      *
+ *   Copyright (C) 2026  FreeSynd Team                                  *
+ *                                                                      *
+ *    This program is free software;  you can redistribute it and / or  *
+ *  modify it  under the  terms of the  GNU General  Public License as  *
+ *  published by the Free Software Foundation; either version 2 of the  *
+ *  License, or (at your option) any later version.                     *
+ *                                                                      *
+ *    This program is  distributed in the hope that it will be useful,  *
+ *  but WITHOUT  ANY WARRANTY;  without even  the implied  warranty of  *
+ *  MERCHANTABILITY  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU  *
+ *  General Public License for more details.                            *
+ *                                                                      *
+ *    You can view the GNU  General Public License, online, at the GNU  *
+ *  project's  web  site;  see <http://www.gnu.org/licenses/gpl.html>.  *
+ *  The full text of the license is also included in the file COPYING.  *
+ *                                                                      *
+ ************************************************************************/
+
+
+#include "fs-utils/misc/workerpool.h"
+
+#include <algorithm>
+
+namespace fs_utils {
+
+const size_t WorkerPool::kMaxDefaultWorkers = 7;
+
+/*!
+ * \param nbWorkers Number of threads to create. With 0, jobs are
+ * run in the calling thread.
+ */
+WorkerPool::WorkerPool(size_t nbWorkers) {
+    pJob_ = NULL;
+    count_ = 0;
+    rangeSize_ = 1;
+    nextIndex_ = 0;
+    busyWorkers_ = 0;
+    generation_ = 0;
+    stopping_ = false;
+
+    workers_.reserve(nbWorkers);
+    for (size_t i = 0; i < nbWorkers; i++) {
+        workers_.push_back(std::thread(&WorkerPool::workerLoop, this));
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    startCond_.notify_all();
+    for (size_t i = 0; i < workers_.size(); i++) {
+        workers_[i].join();
+    }
+}
+
+/*!
+ * One thread is kept for the calling thread.
+ */
+size_t WorkerPool::defaultSize() {
+    unsigned int nbCores = std::thread::hardware_concurrency();
+    if (nbCores <= 1) {
+        return 0;
+    }
+    return std::min(static_cast<size_t>(nbCores - 1), kMaxDefaultWorkers);
+}
+
+/*!
+ * The job must not modify data that is read by the job on other indexes.
+ * \param count Number of indexes
+ * \param job Function called on ranges of indexes
+ */
+void WorkerPool::run(size_t count, const Job &job) {
+    if (count == 0) {
+        return;
+    }
+    if (workers_.empty() || count == 1) {
+        job(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pJob_ = &job;
+        count_ = count;
+        // several ranges per thread so a slow range does not stop the others
+        rangeSize_ = std::max(static_cast<size_t>(1), count / ((workers_.size() + 1) * 4));
+        nextIndex_ = 0;
+        busyWorkers_ = workers_.size();
+        generation_++;
+    }
+    startCond_.notify_all();
+
+    runRanges();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    doneCond_.wait(lock, [this] { return busyWorkers_ == 0; });
+    pJob_ = NULL;
+}
+
+void WorkerPool::runRanges() {
+    for (;;) {
+        size_t first = nextIndex_.fetch_add(rangeSize_);
+        if (first >= count_) {
+            break;
+        }
+        (*pJob_)(first, std::min(first + rangeSize_, count_));
+    }
+}
+
+void WorkerPool::workerLoop() {
+    uint32 lastGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            startCond_.wait(lock, [this, lastGeneration] {
+                return stopping_ || generation_ != lastGeneration;
+            });
+            if (stopping_) {
+                return;
+            }
+            lastGeneration = generation_;
+        }
+
+        runRanges();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busyWorkers_--;
+        }
+        doneCond_.notify_one();
+    }
+}
+
+}